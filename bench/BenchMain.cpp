@@ -0,0 +1,153 @@
+#include <juce_events/juce_events.h>
+#include "BenchmarkSuite.h"
+#include "PerfGate.h"
+#include "PoolScaling.h"
+#include <iostream>
+
+namespace
+{
+    const char* const usage =
+        "Usage: MultiColorCompBench [options]\n"
+        "\n"
+        "Options:\n"
+        "  -o, --output <file>     Write the JSON report here (default: stdout)\n"
+        "  -f, --filter <text>     Only cases whose name contains text (repeatable)\n"
+        "  --rates <list>          Comma-separated sample rates (default 44100,48000,96000,192000)\n"
+        "  --blocks <list>         Comma-separated block sizes (default 16..4096, powers of two)\n"
+        "  --seconds <s>           Audio time per repeat (default 1.0)\n"
+        "  --repeats <n>           Repeats per measurement, fastest is kept (default 3)\n"
+        "  --quick                 48 kHz at 64 and 512 samples only\n"
+        "  --list                  Print case names and exit\n"
+        "\n"
+        "Regression gate:\n"
+        "  --check <baseline.json> Run the fixed scenario and compare with the baseline\n"
+        "  --tolerance <fraction>  Allowed slowdown per module (default 0.25)\n"
+        "  --write-baseline        With --check: record the baseline instead of comparing\n"
+        "\n"
+        "Shared worker pool:\n"
+        "  --pool-scaling          Time 1-128 Soothe instances, Inline vs Shared Pool\n"
+        "                          (paced at real time; --seconds sets the length of each run)\n"
+        "  --instances <list>      Comma-separated instance counts (default 1,2,4,...,128)\n";
+
+    template <typename T>
+    std::vector<T> parseList(const juce::String& text)
+    {
+        std::vector<T> values;
+        for (const auto& token : juce::StringArray::fromTokens(text, ",", ""))
+            if (token.trim().isNotEmpty())
+                values.push_back(static_cast<T>(token.trim().getDoubleValue()));
+        return values;
+    }
+
+    int writeReport(const juce::var& report, const juce::File& outputFile)
+    {
+        const auto json = juce::JSON::toString(report);
+
+        if (outputFile == juce::File())
+            std::cout << json << std::endl;
+        else if (!outputFile.replaceWithText(json))
+        {
+            std::cerr << "Could not write " << outputFile.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // The parameter tree expects a message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    Bench::Settings settings;
+    juce::File outputFile;
+    bool listOnly = false;
+    Bench::GateSettings gateSettings;
+    bool runGate = false;
+    Bench::PoolScalingSettings scalingSettings;
+    bool runScaling = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg(argv[i]);
+        auto nextValue = [&]() { return i + 1 < argc ? juce::String(argv[++i]) : juce::String(); };
+
+        if (arg == "-o" || arg == "--output")
+            outputFile = juce::File::getCurrentWorkingDirectory().getChildFile(nextValue());
+        else if (arg == "-f" || arg == "--filter")
+            settings.filters.add(nextValue());
+        else if (arg == "--rates")
+            settings.sampleRates = parseList<double>(nextValue());
+        else if (arg == "--blocks")
+            settings.blockSizes = parseList<int>(nextValue());
+        else if (arg == "--seconds")
+            settings.secondsPerRun = scalingSettings.seconds = nextValue().getDoubleValue();
+        else if (arg == "--repeats")
+            settings.repeats = nextValue().getIntValue();
+        else if (arg == "--quick")
+        {
+            settings.sampleRates = {48000.0};
+            settings.blockSizes = {64, 512};
+        }
+        else if (arg == "--list")
+            listOnly = true;
+        else if (arg == "--check")
+        {
+            runGate = true;
+            gateSettings.baselineFile = juce::File::getCurrentWorkingDirectory().getChildFile(nextValue());
+        }
+        else if (arg == "--tolerance")
+            gateSettings.tolerance = nextValue().getDoubleValue();
+        else if (arg == "--write-baseline")
+            gateSettings.writeBaseline = true;
+        else if (arg == "--pool-scaling")
+            runScaling = true;
+        else if (arg == "--instances")
+            scalingSettings.instanceCounts = parseList<int>(nextValue());
+        else
+        {
+            std::cerr << "Unknown option: " << arg << "\n\n" << usage;
+            return 2;
+        }
+    }
+
+    if (runGate)
+        return Bench::runPerfGate(gateSettings);
+
+    if (runScaling)
+        return writeReport(Bench::toJSON(Bench::runPoolScaling(scalingSettings)), outputFile);
+
+    std::vector<Bench::Case> cases;
+    for (const auto& benchCase : Bench::createCases())
+        if (Bench::matchesFilters(benchCase, settings.filters))
+            cases.push_back(benchCase);
+
+    if (listOnly)
+    {
+        for (const auto& benchCase : cases)
+            std::cout << benchCase.name << std::endl;
+        return 0;
+    }
+
+    std::vector<Bench::Measurement> measurements;
+
+    for (const auto& benchCase : cases)
+    {
+        for (const double sampleRate : settings.sampleRates)
+        {
+            for (const int blockSize : settings.blockSizes)
+            {
+                const auto m = Bench::run(benchCase, sampleRate, blockSize, settings);
+                measurements.push_back(m);
+
+                // Progress goes to stderr so stdout stays valid JSON
+                std::cerr << benchCase.name << "  " << sampleRate << " Hz  " << blockSize << " smp  "
+                          << juce::String(m.nsPerSample, 1) << " ns/smp  "
+                          << juce::String(m.realtimeFactor, 0) << "x realtime" << std::endl;
+            }
+        }
+    }
+
+    return writeReport(Bench::toJSON(measurements), outputFile);
+}
@@ -0,0 +1,257 @@
+#include "BenchmarkSuite.h"
+#include "Stimulus.h"
+#include "offline/HeadlessProcessor.h"
+#include "dsp/CompressorModule.h"
+#include "dsp/ColorModule.h"
+#include "dsp/SootheModule.h"
+#include "dsp/RouterModule.h"
+#include <chrono>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+ #include <x86intrin.h>
+ #define MCC_BENCH_HAS_TSC 1
+#elif defined(_M_X64) || defined(_M_IX86)
+ #include <intrin.h>
+ #define MCC_BENCH_HAS_TSC 1
+#else
+ #define MCC_BENCH_HAS_TSC 0
+#endif
+
+namespace Bench
+{
+    namespace
+    {
+        juce::uint64 readCycleCounter()
+        {
+           #if MCC_BENCH_HAS_TSC
+            return static_cast<juce::uint64>(__rdtsc());
+           #else
+            return 0;
+           #endif
+        }
+
+        /** Times process() over settings.secondsPerRun of audio, fastest repeat wins */
+        template <typename ProcessFunction>
+        Measurement measure(double sampleRate, int blockSize, const Settings& settings, ProcessFunction&& process)
+        {
+            // One two-second bar of the drum loop, replayed
+            const auto stimulus = createDrumLoopStimulus(sampleRate, static_cast<int>(sampleRate * 2.0));
+            const int stimulusLength = stimulus.getNumSamples();
+
+            juce::AudioBuffer<float> work(2, blockSize);
+            const int numBlocks = juce::jmax(1, static_cast<int>(settings.secondsPerRun * sampleRate) / blockSize);
+
+            auto runBlocks = [&](int count) {
+                int position = 0;
+
+                for (int b = 0; b < count; ++b)
+                {
+                    if (position + blockSize > stimulusLength)
+                        position = 0;
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        work.copyFrom(ch, 0, stimulus, ch, position, blockSize);
+
+                    process(work);
+                    position += blockSize;
+                }
+            };
+
+            // Warm up caches, smoothers and lazily sized state
+            runBlocks(juce::jmax(1, numBlocks / 10));
+
+            double bestSeconds = std::numeric_limits<double>::max();
+            juce::uint64 bestCycles = 0;
+
+            for (int r = 0; r < juce::jmax(1, settings.repeats); ++r)
+            {
+                const auto startCycles = readCycleCounter();
+                const auto startTime = std::chrono::steady_clock::now();
+
+                runBlocks(numBlocks);
+
+                const auto endTime = std::chrono::steady_clock::now();
+                const auto endCycles = readCycleCounter();
+                const double seconds = std::chrono::duration<double>(endTime - startTime).count();
+
+                if (seconds < bestSeconds)
+                {
+                    bestSeconds = seconds;
+                    bestCycles = endCycles - startCycles;
+                }
+            }
+
+            const double numSamples = static_cast<double>(numBlocks) * blockSize;
+
+            Measurement m;
+            m.sampleRate = sampleRate;
+            m.blockSize = blockSize;
+            m.nsPerSample = bestSeconds * 1.0e9 / numSamples;
+            m.cyclesPerSample = static_cast<double>(bestCycles) / numSamples;
+            m.realtimeFactor = (numSamples / sampleRate) / juce::jmax(1.0e-12, bestSeconds);
+            return m;
+        }
+
+        template <typename Module>
+        Measurement measureModule(HeadlessProcessor& host, const juce::dsp::ProcessSpec& spec, const Settings& settings)
+        {
+            auto module = std::make_unique<Module>();
+            module->prepare(spec);
+
+            return measure(spec.sampleRate, static_cast<int>(spec.maximumBlockSize), settings,
+                           [&](juce::AudioBuffer<float>& buffer) {
+                               juce::dsp::AudioBlock<float> block(buffer);
+                               module->processActive(block, host.getParameters());
+                           });
+        }
+    }
+
+    juce::StringPairArray makeParams(std::initializer_list<std::pair<const char*, const char*>> values)
+    {
+        juce::StringPairArray params;
+        for (const auto& [id, value] : values)
+            params.set(id, value);
+        return params;
+    }
+
+    std::vector<Case> createCases()
+    {
+        std::vector<Case> cases;
+
+        for (auto* style : {"VCA", "FET", "Opto", "Vari-Mu"})
+            cases.push_back({juce::String("compressor/") + style, Target::Compressor,
+                             makeParams({{"comp_style", style}, {"comp_threshold", "-30"}})});
+
+        for (auto* type : {"Tape", "Tube", "Transformer", "Clip"})
+            for (auto* os : {"Off", "2x", "4x", "8x"})
+                cases.push_back({juce::String("color/") + type + "/" + os, Target::Color,
+                                 makeParams({{"color_type", type}, {"color_os", os}})});
+
+        for (auto* quality : {"Eco", "Normal", "High"})
+            cases.push_back({juce::String("soothe/") + quality, Target::Soothe,
+                             makeParams({{"soothe_quality", quality}})});
+
+        // Router and processBlock run all three modules
+        const char* const routes[] = {"Soothe->Comp->Color", "Comp->Color->Soothe", "Soothe->Color->Comp",
+                                      "Comp->Soothe->Color", "Color->Comp->Soothe", "Color->Soothe->Comp"};
+
+        for (auto* route : routes)
+            cases.push_back({juce::String("router/") + route, Target::Router,
+                             makeParams({{"routing", route}, {"soothe_bypass", "0"}})});
+
+        cases.push_back({"processBlock", Target::ProcessBlock, makeParams({{"soothe_bypass", "0"}})});
+
+        return cases;
+    }
+
+    bool matchesFilters(const Case& benchCase, const juce::StringArray& filters)
+    {
+        if (filters.isEmpty())
+            return true;
+
+        for (const auto& filter : filters)
+            if (benchCase.name.containsIgnoreCase(filter))
+                return true;
+
+        return false;
+    }
+
+    Measurement run(const Case& benchCase, double sampleRate, int blockSize, const Settings& settings)
+    {
+        auto host = std::make_unique<HeadlessProcessor>();
+
+        for (const auto& id : benchCase.params.getAllKeys())
+        {
+            const auto result = host->setParameter(id, benchCase.params[id]);
+            jassertquiet(result.wasOk());
+        }
+
+        juce::dsp::ProcessSpec spec;
+        spec.sampleRate = sampleRate;
+        spec.maximumBlockSize = static_cast<juce::uint32>(blockSize);
+        spec.numChannels = 2;
+
+        Measurement m;
+
+        switch (benchCase.target)
+        {
+            case Target::Compressor:
+                m = measureModule<CompressorModule>(*host, spec, settings);
+                break;
+
+            case Target::Color:
+                m = measureModule<ColorModule>(*host, spec, settings);
+                break;
+
+            case Target::Soothe:
+                m = measureModule<SootheModule>(*host, spec, settings);
+                break;
+
+            case Target::Router:
+            {
+                auto router = std::make_unique<RouterModule>();
+                router->prepare(spec);
+
+                m = measure(sampleRate, blockSize, settings, [&](juce::AudioBuffer<float>& buffer) {
+                    juce::dsp::AudioBlock<float> block(buffer);
+                    juce::dsp::ProcessContextReplacing<float> context(block);
+                    router->process(context, host->getParameters());
+                });
+                break;
+            }
+
+            case Target::ProcessBlock:
+            {
+                host->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+                host->prepareToPlay(sampleRate, blockSize);
+                juce::MidiBuffer midi;
+
+                m = measure(sampleRate, blockSize, settings, [&](juce::AudioBuffer<float>& buffer) {
+                    host->processBlock(buffer, midi);
+                });
+                break;
+            }
+        }
+
+        m.caseName = benchCase.name;
+        return m;
+    }
+
+    juce::var toJSON(const std::vector<Measurement>& measurements)
+    {
+        auto* root = new juce::DynamicObject();
+        root->setProperty("format", 1);
+        root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("cpu", juce::SystemStats::getCpuVendor() + " " + juce::SystemStats::getCpuModel());
+        root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+       #if JUCE_DEBUG
+        root->setProperty("build", "Debug");
+       #else
+        root->setProperty("build", "Release");
+       #endif
+        root->setProperty("cycleCounter", hasCycleCounter());
+
+        juce::Array<juce::var> results;
+
+        for (const auto& m : measurements)
+        {
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("case", m.caseName);
+            entry->setProperty("sampleRate", m.sampleRate);
+            entry->setProperty("blockSize", m.blockSize);
+            entry->setProperty("nsPerSample", m.nsPerSample);
+            entry->setProperty("cyclesPerSample", m.cyclesPerSample);
+            entry->setProperty("realtimeFactor", m.realtimeFactor);
+            results.add(juce::var(entry));
+        }
+
+        root->setProperty("results", results);
+        return juce::var(root);
+    }
+
+    bool hasCycleCounter()
+    {
+        return MCC_BENCH_HAS_TSC != 0;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+/**
+ * Microbenchmarks for the DSP modules, the router and the full processBlock
+ * Each case configures a headless parameter tree, then times a module over
+ * a fixed amount of audio at one sample rate / block size. The fastest of
+ * several repeats is kept, which filters out scheduler noise.
+ */
+namespace Bench
+{
+    struct Settings
+    {
+        std::vector<double> sampleRates{44100.0, 48000.0, 96000.0, 192000.0};
+        std::vector<int> blockSizes{16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+        double secondsPerRun = 1.0;  // Audio time processed per repeat
+        int repeats = 3;
+        juce::StringArray filters;   // Case name substrings; empty = all cases
+    };
+
+    struct Measurement
+    {
+        juce::String caseName;
+        double sampleRate = 0.0;
+        int blockSize = 0;
+        double nsPerSample = 0.0;      // Per sample frame (all channels)
+        double cyclesPerSample = 0.0;  // Timestamp-counter ticks; 0 if unavailable
+        double realtimeFactor = 0.0;   // Audio time / processing time
+    };
+
+    enum class Target
+    {
+        Compressor,
+        Color,
+        Soothe,
+        Router,
+        ProcessBlock
+    };
+
+    struct Case
+    {
+        juce::String name;
+        Target target;
+        juce::StringPairArray params;  // Parameter ID -> value, as accepted by HeadlessProcessor::setParameter
+    };
+
+    // Parameter ID -> value pairs for a Case
+    juce::StringPairArray makeParams(std::initializer_list<std::pair<const char*, const char*>> values);
+
+    // Every module configuration worth timing
+    std::vector<Case> createCases();
+
+    bool matchesFilters(const Case& benchCase, const juce::StringArray& filters);
+
+    Measurement run(const Case& benchCase, double sampleRate, int blockSize, const Settings& settings);
+
+    // Machine-readable report, one entry per measurement
+    juce::var toJSON(const std::vector<Measurement>& measurements);
+
+    bool hasCycleCounter();
+}
@@ -0,0 +1,199 @@
+#include "PerfGate.h"
+#include "BenchmarkSuite.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace Bench
+{
+    namespace
+    {
+        constexpr double gateSampleRate = 48000.0;
+        constexpr int gateBlockSize = 512;
+
+       #if JUCE_DEBUG
+        const juce::String buildType = "Debug";
+       #else
+        const juce::String buildType = "Release";
+       #endif
+
+        // One case per module, plus the whole chain
+        std::vector<Case> createGateCases()
+        {
+            return {
+                {"compressor", Target::Compressor, makeParams({{"comp_threshold", "-30"}})},
+                {"color", Target::Color, makeParams({})},
+                {"soothe", Target::Soothe, makeParams({})},
+                {"router", Target::Router, makeParams({{"soothe_bypass", "0"}})},
+                {"processBlock", Target::ProcessBlock, makeParams({{"soothe_bypass", "0"}})},
+            };
+        }
+
+        // ns per iteration of a fixed dependent multiply-add chain (biquad-like)
+        double measureCalibration()
+        {
+            constexpr int iterations = 4'000'000;
+            double best = std::numeric_limits<double>::max();
+            volatile float sink = 0.0f;
+
+            for (int r = 0; r < 5; ++r)
+            {
+                float x1 = 0.0f, y1 = 0.0f, y2 = 0.0f;
+                const auto start = std::chrono::steady_clock::now();
+
+                for (int i = 0; i < iterations; ++i)
+                {
+                    const float x = static_cast<float>(i & 255) * (1.0f / 256.0f);
+                    const float y = 0.2f * x + 0.4f * x1 + 1.6f * y1 - 0.64f * y2;
+                    x1 = x;
+                    y2 = y1;
+                    y1 = y;
+                }
+
+                const auto end = std::chrono::steady_clock::now();
+                sink = y1;
+                best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / iterations);
+            }
+
+            juce::ignoreUnused(sink);
+            return best;
+        }
+
+        bool isValidCost(double value)
+        {
+            return std::isfinite(value) && value > 0.0;
+        }
+
+        bool writeBaselineFile(const juce::File& file, double calibrationNs, const std::vector<Measurement>& measurements)
+        {
+            auto* modules = new juce::DynamicObject();
+
+            for (const auto& m : measurements)
+            {
+                auto* entry = new juce::DynamicObject();
+                entry->setProperty("nsPerSample", m.nsPerSample);
+                entry->setProperty("relativeCost", m.nsPerSample / calibrationNs);
+                modules->setProperty(m.caseName, juce::var(entry));
+            }
+
+            auto* root = new juce::DynamicObject();
+            root->setProperty("format", 1);
+            root->setProperty("build", buildType);
+            root->setProperty("scenario", "drum loop + pink noise, 48 kHz, 512-sample blocks");
+            root->setProperty("cpu", juce::SystemStats::getCpuVendor() + " " + juce::SystemStats::getCpuModel());
+            root->setProperty("calibrationNs", calibrationNs);
+            root->setProperty("modules", juce::var(modules));
+
+            return file.replaceWithText(juce::JSON::toString(juce::var(root)) + "\n");
+        }
+    }
+
+    int runPerfGate(const GateSettings& settings)
+    {
+        juce::var baseline;
+
+        // Check the baseline before spending a minute measuring. A missing
+        // or partial baseline fails: the gate must never pass unchecked.
+        if (!settings.writeBaseline)
+        {
+            baseline = juce::JSON::parse(settings.baselineFile);
+
+            if (!baseline.isObject())
+            {
+                std::cerr << "No readable baseline at " << settings.baselineFile.getFullPathName()
+                          << "; record it with --write-baseline" << std::endl;
+                return gateInvalid;
+            }
+
+            // Debug timings say nothing about a Release baseline (or vice versa)
+            if (baseline["build"].toString() != buildType)
+            {
+                std::cout << "Baseline is a " << baseline["build"].toString() << " build, this is " << buildType << ", skipping" << std::endl;
+                return gateSkipped;
+            }
+
+            // A zero calibration means the file was never recorded on a machine
+            const double baselineCalibrationNs = baseline["calibrationNs"];
+
+            if (!isValidCost(baselineCalibrationNs))
+            {
+                std::cerr << settings.baselineFile.getFullPathName() << " has no calibration (calibrationNs "
+                          << baselineCalibrationNs << "); record it with --write-baseline" << std::endl;
+                return gateInvalid;
+            }
+
+            for (const auto& gateCase : createGateCases())
+            {
+                if (!isValidCost(static_cast<double>(baseline["modules"][juce::Identifier(gateCase.name)]["relativeCost"])))
+                {
+                    std::cerr << settings.baselineFile.getFullPathName() << " has no valid entry for " << gateCase.name
+                              << "; re-record it with --write-baseline" << std::endl;
+                    return gateInvalid;
+                }
+            }
+        }
+
+        Settings benchSettings;
+        benchSettings.secondsPerRun = 2.0;
+        benchSettings.repeats = 5;
+
+        const double calibrationNs = measureCalibration();
+
+        std::vector<Measurement> measurements;
+        for (const auto& gateCase : createGateCases())
+            measurements.push_back(run(gateCase, gateSampleRate, gateBlockSize, benchSettings));
+
+        if (settings.writeBaseline)
+        {
+            // Every cost is stored relative to the calibration, so a broken
+            // timer would make the whole baseline meaningless
+            if (!isValidCost(calibrationNs))
+            {
+                std::cerr << "Calibration measured " << calibrationNs << " ns, not writing a baseline" << std::endl;
+                return gateInvalid;
+            }
+
+            if (!writeBaselineFile(settings.baselineFile, calibrationNs, measurements))
+            {
+                std::cerr << "Could not write " << settings.baselineFile.getFullPathName() << std::endl;
+                return gateInvalid;
+            }
+
+            std::cout << "Baseline written to " << settings.baselineFile.getFullPathName() << std::endl;
+            return gatePassed;
+        }
+
+        if (!isValidCost(calibrationNs))
+        {
+            std::cerr << "Calibration measured " << calibrationNs << " ns, cannot compare" << std::endl;
+            return gateInvalid;
+        }
+
+        const auto modules = baseline["modules"];
+        bool regressed = false;
+
+        std::cout << "Calibration: " << juce::String(calibrationNs, 3) << " ns/iteration, tolerance "
+                  << juce::roundToInt(settings.tolerance * 100.0) << "%" << std::endl;
+
+        for (const auto& m : measurements)
+        {
+            const double relativeCost = m.nsPerSample / calibrationNs;
+            const double baselineCost = static_cast<double>(modules[juce::Identifier(m.caseName)]["relativeCost"]);
+            const double change = relativeCost / baselineCost - 1.0;
+
+            std::cout << "  " << m.caseName.paddedRight(' ', 14) << juce::String(m.nsPerSample, 2) << " ns/smp"
+                      << "  " << (change >= 0.0 ? "+" : "") << juce::String(change * 100.0, 1) << "%";
+
+            if (change > settings.tolerance)
+            {
+                std::cout << "  REGRESSION";
+                regressed = true;
+            }
+
+            std::cout << std::endl;
+        }
+
+        return regressed ? gateRegressed : gatePassed;
+    }
+}
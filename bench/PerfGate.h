@@ -0,0 +1,31 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+namespace Bench
+{
+    /**
+     * Performance regression check against a committed baseline
+     * Renders a fixed scenario (drum-loop stimulus, 48 kHz, 512-sample blocks)
+     * through each module and compares per-module cost with the baseline.
+     * Costs are stored relative to a fixed calibration workload so a baseline
+     * recorded on one machine stays meaningful on another of similar class.
+     */
+    struct GateSettings
+    {
+        juce::File baselineFile;
+        double tolerance = 0.25;  // Allowed slowdown before failing (0.25 = 25%)
+        bool writeBaseline = false;
+    };
+
+    // Exit codes for ctest
+    enum GateResult
+    {
+        gatePassed = 0,
+        gateRegressed = 1,
+        gateInvalid = 2,  // Baseline missing, incomplete or unusable, or could not be written
+        gateSkipped = 77  // Baseline from another build type
+    };
+
+    int runPerfGate(const GateSettings& settings);
+}
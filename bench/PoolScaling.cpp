@@ -0,0 +1,166 @@
+#include "PoolScaling.h"
+#include "Stimulus.h"
+#include "offline/HeadlessProcessor.h"
+#include "dsp/SootheModule.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+namespace Bench
+{
+    namespace
+    {
+        constexpr double scalingSampleRate = 48000.0;
+        constexpr int scalingBlockSize = 256;
+
+        PoolScalingResult measureScaling(int numInstances, SootheModule::Scheduling scheduling, double seconds)
+        {
+            using Clock = std::chrono::steady_clock;
+
+            // One parameter tree drives every instance; it is only read
+            HeadlessProcessor host;
+            for (const auto& [id, value] : {std::pair<const char*, juce::String>{"soothe_quality", "High"},
+                                            {"soothe_scheduling", juce::String(static_cast<int>(scheduling))}})
+            {
+                const auto configured = host.setParameter(id, value);
+                jassertquiet(configured.wasOk());
+            }
+
+            const juce::dsp::ProcessSpec spec{scalingSampleRate, static_cast<juce::uint32>(scalingBlockSize), 2};
+            std::vector<std::unique_ptr<SootheModule>> instances;
+            std::vector<juce::AudioBuffer<float>> buffers;
+
+            for (int i = 0; i < numInstances; ++i)
+            {
+                instances.push_back(std::make_unique<SootheModule>());
+                instances.back()->prepare(spec);
+                instances.back()->updateSettings(host.getParameters());
+                instances.back()->startBackgroundThreads();
+                buffers.emplace_back(2, scalingBlockSize);
+            }
+
+            juce::SharedResourcePointer<SpectralWorkerPool> pool;
+            const auto poolRunsBefore = pool->getNumRunByPool();
+            const auto inlineRunsBefore = pool->getNumRunInline();
+            const auto lateBefore = pool->getNumLate();
+
+            const auto stimulus = createDrumLoopStimulus(scalingSampleRate, static_cast<int>(scalingSampleRate * 2.0));
+            const auto blockDuration = std::chrono::duration<double>(scalingBlockSize / scalingSampleRate);
+            const int numBlocks = juce::jmax(1, static_cast<int>(seconds * scalingSampleRate) / scalingBlockSize);
+            const int warmUpBlocks = juce::jmax(1, numBlocks / 10);
+
+            PoolScalingResult result;
+            result.scheduling = scheduling == SootheModule::Scheduling::SharedPool ? "Shared Pool" : "Inline";
+            result.numInstances = numInstances;
+
+            double totalLoad = 0.0;
+            int position = 0;
+            auto deadline = Clock::now();
+
+            for (int b = 0; b < warmUpBlocks + numBlocks; ++b)
+            {
+                if (position + scalingBlockSize > stimulus.getNumSamples())
+                    position = 0;
+
+                // Host copies each track's input before the callback starts
+                for (auto& buffer : buffers)
+                    for (int ch = 0; ch < 2; ++ch)
+                        buffer.copyFrom(ch, 0, stimulus, ch, position, scalingBlockSize);
+
+                const auto start = Clock::now();
+
+                for (size_t i = 0; i < instances.size(); ++i)
+                {
+                    juce::dsp::AudioBlock<float> block(buffers[i]);
+                    instances[i]->processActive(block, host.getParameters());
+                }
+
+                const auto end = Clock::now();
+                position += scalingBlockSize;
+
+                if (b >= warmUpBlocks)
+                {
+                    const double load = std::chrono::duration<double>(end - start) / blockDuration;
+                    totalLoad += load;
+                    result.maxLoad = juce::jmax(result.maxLoad, load);
+
+                    if (load > 1.0)
+                        ++result.numOverruns;
+                }
+
+                // Wait for the next period; an overrun starts it late
+                deadline = juce::jmax(deadline + std::chrono::duration_cast<Clock::duration>(blockDuration), end);
+                std::this_thread::sleep_until(deadline);
+            }
+
+            result.averageLoad = totalLoad / numBlocks;
+
+            const auto poolRuns = static_cast<double>(pool->getNumRunByPool() - poolRunsBefore);
+            const auto inlineRuns = static_cast<double>(pool->getNumRunInline() - inlineRunsBefore);
+
+            if (poolRuns + inlineRuns > 0.0)
+                result.poolShare = poolRuns / (poolRuns + inlineRuns);
+
+            result.numLateFrames = pool->getNumLate() - lateBefore;
+
+            return result;
+        }
+    }
+
+    std::vector<PoolScalingResult> runPoolScaling(const PoolScalingSettings& settings)
+    {
+        std::vector<PoolScalingResult> results;
+
+        for (const int numInstances : settings.instanceCounts)
+        {
+            for (const auto scheduling : {SootheModule::Scheduling::Inline, SootheModule::Scheduling::SharedPool})
+            {
+                const auto r = measureScaling(numInstances, scheduling, settings.seconds);
+                results.push_back(r);
+
+                // Progress goes to stderr so stdout stays valid JSON
+                std::cerr << r.numInstances << " x soothe  " << r.scheduling << "  avg "
+                          << juce::String(r.averageLoad * 100.0, 1) << "%  max "
+                          << juce::String(r.maxLoad * 100.0, 1) << "%  overruns " << r.numOverruns;
+
+                if (scheduling == SootheModule::Scheduling::SharedPool)
+                    std::cerr << "  pool " << juce::String(r.poolShare * 100.0, 0) << "%  late " << r.numLateFrames;
+
+                std::cerr << std::endl;
+            }
+        }
+
+        return results;
+    }
+
+    juce::var toJSON(const std::vector<PoolScalingResult>& results)
+    {
+        juce::SharedResourcePointer<SpectralWorkerPool> pool;
+
+        auto* root = new juce::DynamicObject();
+        root->setProperty("format", 1);
+        root->setProperty("timestamp", juce::Time::getCurrentTime().toISO8601(true));
+        root->setProperty("cpu", juce::SystemStats::getCpuVendor() + " " + juce::SystemStats::getCpuModel());
+        root->setProperty("poolThreads", pool->getNumThreads());
+        root->setProperty("scenario", "soothe High, 48 kHz, 256-sample blocks, paced at real time");
+
+        juce::Array<juce::var> entries;
+
+        for (const auto& r : results)
+        {
+            auto* entry = new juce::DynamicObject();
+            entry->setProperty("scheduling", r.scheduling);
+            entry->setProperty("instances", r.numInstances);
+            entry->setProperty("averageLoad", r.averageLoad);
+            entry->setProperty("maxLoad", r.maxLoad);
+            entry->setProperty("overruns", r.numOverruns);
+            entry->setProperty("poolShare", r.poolShare);
+            entry->setProperty("lateFrames", r.numLateFrames);
+            entries.add(juce::var(entry));
+        }
+
+        root->setProperty("results", entries);
+        return juce::var(root);
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace Bench
+{
+    /**
+     * Scaling benchmark for Soothe's shared worker pool
+     * Runs N Soothe instances (High quality, 48 kHz, 256-sample blocks) in
+     * one simulated host callback, paced at real time so pool threads get
+     * the gaps between callbacks, as in a DAW. Each N runs with Inline and
+     * Shared Pool scheduling; the figure of merit is callback time against
+     * the block's deadline.
+     */
+    struct PoolScalingSettings
+    {
+        std::vector<int> instanceCounts{1, 2, 4, 8, 16, 32, 64, 128};
+        double seconds = 2.0;  // Audio time per configuration
+    };
+
+    struct PoolScalingResult
+    {
+        juce::String scheduling;
+        int numInstances = 0;
+        double averageLoad = 0.0;  // Callback time / block duration
+        double maxLoad = 0.0;
+        int numOverruns = 0;       // Callbacks that missed their deadline
+        double poolShare = 0.0;    // Frames run by pool threads (rest ran inline)
+        juce::int64 numLateFrames = 0;  // Still running at their deadline (played dry)
+    };
+
+    std::vector<PoolScalingResult> runPoolScaling(const PoolScalingSettings& settings);
+
+    juce::var toJSON(const std::vector<PoolScalingResult>& results);
+}
@@ -0,0 +1,73 @@
+#include "Stimulus.h"
+#include <cmath>
+
+namespace Bench
+{
+    juce::AudioBuffer<float> createDrumLoopStimulus(double sampleRate, int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(2, numSamples);
+        juce::Random random(0x4d4343);  // Fixed seed
+
+        // One bar of 16th notes at 120 BPM
+        constexpr double stepSeconds = 0.125;
+        constexpr int numSteps = 16;
+        constexpr bool kickSteps[numSteps] = {1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0};
+        constexpr bool snareSteps[numSteps] = {0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1};
+
+        const auto stepLength = static_cast<int>(stepSeconds * sampleRate);
+        const auto twoPi = juce::MathConstants<double>::twoPi;
+
+        // Pink noise filter state (Paul Kellet's economy method), per channel
+        float pink[2][3] = {};
+        float previousHatNoise = 0.0f;
+        double kickPhase = 0.0;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const int step = (i / stepLength) % numSteps;
+            const double t = static_cast<double>(i % stepLength) / sampleRate;
+
+            // Kick: pitch-swept sine
+            float kick = 0.0f;
+            if (kickSteps[step])
+            {
+                if (i % stepLength == 0)
+                    kickPhase = 0.0;
+
+                const double frequency = 50.0 + 100.0 * std::exp(-t * 30.0);
+                kickPhase += twoPi * frequency / sampleRate;
+                kick = 0.8f * static_cast<float>(std::sin(kickPhase) * std::exp(-t * 8.0));
+            }
+
+            // Snare: noise burst plus body tone
+            const float noise = random.nextFloat() * 2.0f - 1.0f;
+            float snare = 0.0f;
+            if (snareSteps[step])
+                snare = static_cast<float>(0.4 * noise * std::exp(-t * 20.0)
+                                           + 0.3 * std::sin(twoPi * 180.0 * t) * std::exp(-t * 25.0));
+
+            // Closed hi-hat on every other 16th: differentiated noise
+            const float hatNoise = random.nextFloat() * 2.0f - 1.0f;
+            float hat = 0.0f;
+            if (step % 2 == 0)
+                hat = static_cast<float>(0.2 * (hatNoise - previousHatNoise) * std::exp(-t * 60.0));
+            previousHatNoise = hatNoise;
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const float white = random.nextFloat() * 2.0f - 1.0f;
+                auto& b = pink[ch];
+                b[0] = 0.99765f * b[0] + white * 0.0990460f;
+                b[1] = 0.96300f * b[1] + white * 0.2965164f;
+                b[2] = 0.57000f * b[2] + white * 1.0526913f;
+                const float pinkNoise = (b[0] + b[1] + b[2] + white * 0.1848f) * 0.05f;
+
+                // Hats sit slightly right
+                const float hatGain = ch == 0 ? 0.8f : 1.0f;
+                buffer.setSample(ch, i, pinkNoise + kick + snare + hat * hatGain);
+            }
+        }
+
+        return buffer;
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace Bench
+{
+    /**
+     * Deterministic benchmark stimulus: decorrelated pink noise under a
+     * 120 BPM kick/snare/hi-hat loop, stereo. Identical for a given sample
+     * rate and length, so timings never depend on external audio files.
+     */
+    juce::AudioBuffer<float> createDrumLoopStimulus(double sampleRate, int numSamples);
+}
@@ -0,0 +1,98 @@
+#include "ChainProcessor.h"
+
+ChainProcessor::ChainProcessor(LatencyReporting reporting)
+    : AudioProcessor(BusesProperties()
+                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
+                         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
+      parameters(*this),
+      latencyReporting(reporting)
+{
+}
+
+ChainProcessor::~ChainProcessor()
+{
+    cancelPendingUpdate();
+}
+
+void ChainProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+{
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
+    spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
+
+    router.prepare(spec);
+
+    // Not playing yet, so the host can be told directly
+    cancelPendingUpdate();
+    pendingLatency.store(router.getLatencySamples());
+    setLatencySamples(pendingLatency.load());
+}
+
+void ChainProcessor::releaseResources()
+{
+    router.reset();
+}
+
+bool ChainProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
+{
+    // Support mono and stereo
+    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
+        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+        return false;
+
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+
+    return true;
+}
+
+void ChainProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    juce::ScopedNoDenormals noDenormals;
+    MCC_TRACE_SCOPE("processBlock");
+
+    if (loudnessResetRequested.exchange(false))
+        router.resetLoudness();
+
+    // Process audio through router
+    juce::dsp::AudioBlock<float> block(buffer);
+    juce::dsp::ProcessContextReplacing<float> context(block);
+
+    router.process(context, parameters);
+
+    // Soothe quality and bypass mode can change the reported latency
+    const int latency = router.getLatencySamples();
+
+    if (latencyReporting == LatencyReporting::Immediate)
+    {
+        if (latency != getLatencySamples())
+            setLatencySamples(latency);
+
+        if (router.needsBackgroundThreads())
+            router.startBackgroundThreads();
+    }
+    else if (pendingLatency.exchange(latency) != latency || router.needsBackgroundThreads())
+    {
+        triggerAsyncUpdate();
+    }
+}
+
+void ChainProcessor::handleAsyncUpdate()
+{
+    router.startBackgroundThreads();
+
+    const int latency = pendingLatency.load();
+    if (latency != getLatencySamples())
+        setLatencySamples(latency);
+}
+
+void ChainProcessor::getStateInformation(juce::MemoryBlock& destData)
+{
+    parameters.saveState(destData);
+}
+
+void ChainProcessor::setStateInformation(const void* data, int sizeInBytes)
+{
+    parameters.loadState(data, sizeInBytes);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include "Parameters.h"
+#include "dsp/RouterModule.h"
+#include "dsp/TraceRecorder.h"
+#include <atomic>
+
+/**
+ * The processing chain shared by the plugin and the headless host
+ * Owns the parameter tree and the RouterModule, and does everything a
+ * processBlock() needs besides publishing to an editor: preparing the chain,
+ * running it, loudness resets, latency reporting and state.
+ */
+class ChainProcessor : public juce::AudioProcessor,
+                       private juce::AsyncUpdater
+{
+public:
+    // Hosts react to a latency change synchronously, so a plugin reports it
+    // (and starts any thread Soothe's scheduling needs) from the message
+    // thread. Headless renders have no message loop and need both before
+    // the next block, so they do it straight away.
+    enum class LatencyReporting
+    {
+        MessageThread,
+        Immediate
+    };
+
+    explicit ChainProcessor(LatencyReporting reporting);
+    ~ChainProcessor() override;
+
+    void prepareToPlay(double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
+
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    bool isMidiEffect() const override { return false; }
+    double getTailLengthSeconds() const override { return 0.0; }
+
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+
+    void getStateInformation(juce::MemoryBlock& destData) override;
+    void setStateInformation(const void* data, int sizeInBytes) override;
+
+    // Parameter access
+    juce::AudioProcessorValueTreeState& getAPVTS() { return parameters.getAPVTS(); }
+    Parameters& getParameters() { return parameters; }
+
+    RouterModule& getRouter() { return router; }
+
+    // Loudness: the editor reads it from the meter frames; offline/headless
+    // callers can query it directly between processBlock() calls
+    const LoudnessReadings& getInputLoudness() const { return router.getInputLoudness(); }
+    const LoudnessReadings& getOutputLoudness() const { return router.getOutputLoudness(); }
+
+    // Restarts integrated loudness, LRA and true-peak hold (safe from any thread)
+    void resetLoudness() { loudnessResetRequested.store(true); }
+
+    // Idle detection
+    juce::int64 getNumSkippedBlocks() const { return router.getNumSkippedBlocks(); }
+
+    // Per-module CPU counters (enable before reading)
+    ProcessingProfiler& getProfiler() { return router.getProfiler(); }
+
+    // Soothe display frames (enable while an editor shows them)
+    SootheDisplay& getSootheDisplay() { return router.getSootheDisplay(); }
+
+    // Compressor GR history points (enable while an editor draws them)
+    GainReductionHistory& getGainReductionHistory() { return router.getGainReductionHistory(); }
+
+protected:
+    Parameters parameters;
+    RouterModule router;
+
+    // Message-thread side of LatencyReporting::MessageThread
+    void handleAsyncUpdate() override;
+
+private:
+    const LatencyReporting latencyReporting;
+    std::atomic<bool> loudnessResetRequested{false};
+
+    // Latency changes seen by processBlock(), waiting for the message thread
+    // (which also starts background threads the router asks for)
+    std::atomic<int> pendingLatency{0};
+
+#if MCC_ENABLE_TRACING
+    // One trace file per process, closed when the last instance goes away
+    juce::SharedResourcePointer<TraceRecorder> traceRecorder;
+#endif
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChainProcessor)
+};
@@ -1,8 +1,47 @@
 #include "Parameters.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    constexpr char stateMagic[4] = {'M', 'C', 'C', 'B'};
+    constexpr int stateVersion = 1;
+    constexpr int stateHeaderSize = 8;  // Magic, version (16 bit), parameter count (16 bit)
+
+    // A parameter's index here is its slot in saved states: append new
+    // parameters at the end, never reorder or remove entries
+    const char* const stateLayout[] = {
+        ParamIDs::inputTrim, ParamIDs::outputTrim, ParamIDs::globalMix, ParamIDs::routing,
+        ParamIDs::intensityMacro, ParamIDs::bypassLatency,
+
+        ParamIDs::compBypass, ParamIDs::compStyle, ParamIDs::compThreshold, ParamIDs::compRatio,
+        ParamIDs::compAttack, ParamIDs::compRelease, ParamIDs::compKnee, ParamIDs::compMakeup,
+        ParamIDs::compMix, ParamIDs::compSCHPF, ParamIDs::compStereoLink,
+
+        ParamIDs::colorBypass, ParamIDs::colorType, ParamIDs::colorDrive, ParamIDs::colorTone,
+        ParamIDs::colorMix, ParamIDs::colorOutput, ParamIDs::colorOS,
+
+        ParamIDs::sootheBypass, ParamIDs::sootheAmount, ParamIDs::sootheSensitivity,
+        ParamIDs::sootheSharpness, ParamIDs::sootheSpeed, ParamIDs::sootheFocusLow,
+        ParamIDs::sootheFocusHigh, ParamIDs::sootheMix, ParamIDs::sootheDelta,
+        ParamIDs::sootheQuality, ParamIDs::sootheOverlap, ParamIDs::sootheAnalysis,
+        ParamIDs::sootheScheduling,
+    };
+}
 
 Parameters::Parameters(juce::AudioProcessor& processor)
     : apvts(processor, nullptr, "Parameters", createParameterLayout())
 {
+    for (auto* id : stateLayout)
+    {
+        auto* param = apvts.getParameter(id);
+        jassert(param != nullptr);  // Every layout entry must be a parameter
+        stateParameters.push_back(param);
+    }
+
+    // Every parameter must have a slot, or saved states silently lose it
+    jassert(stateParameters.size() == static_cast<size_t>(processor.getParameters().size()));
 }
 
 float Parameters::getValue(const juce::String& paramID) const
@@ -49,6 +88,95 @@ float Parameters::getModulatedDrive() const
     return drive + (intensity * 20.0f);
 }
 
+void Parameters::saveState(juce::MemoryBlock& destData)
+{
+    const juce::ScopedLock sl(stateLock);
+
+    // Hosts save for every undo step and autosave, usually with nothing changed
+    bool changed = cachedValues.size() != stateParameters.size();
+
+    for (size_t i = 0; i < stateParameters.size() && !changed; ++i)
+        changed = stateParameters[i]->convertFrom0to1(stateParameters[i]->getValue()) != cachedValues[i];
+
+    if (changed)
+    {
+        cachedValues.resize(stateParameters.size());
+        cachedState.reset();
+
+        juce::MemoryOutputStream out(cachedState, false);
+        out.write(stateMagic, sizeof(stateMagic));
+        out.writeShort(static_cast<short>(stateVersion));
+        out.writeShort(static_cast<short>(stateParameters.size()));
+
+        for (size_t i = 0; i < stateParameters.size(); ++i)
+        {
+            cachedValues[i] = stateParameters[i]->convertFrom0to1(stateParameters[i]->getValue());
+            out.writeFloat(cachedValues[i]);
+        }
+    }
+
+    destData = cachedState;
+}
+
+bool Parameters::loadState(const void* data, int sizeInBytes)
+{
+    if (data == nullptr || sizeInBytes <= 0)
+        return false;
+
+    if (sizeInBytes >= stateHeaderSize && std::memcmp(data, stateMagic, sizeof(stateMagic)) == 0)
+        return loadBinaryState(data, sizeInBytes);
+
+    // States saved before the binary format
+    auto xml = juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes);
+
+    if (xml == nullptr || !xml->hasTagName(apvts.state.getType()))
+        return false;
+
+    apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    return true;
+}
+
+bool Parameters::loadBinaryState(const void* data, int sizeInBytes)
+{
+    juce::MemoryInputStream in(data, static_cast<size_t>(sizeInBytes), false);
+    in.skipNextBytes(sizeof(stateMagic));
+
+    const int version = static_cast<unsigned short>(in.readShort());
+    const int numValues = static_cast<unsigned short>(in.readShort());
+
+    // Newer versions may mean something else by the same bytes
+    if (version < 1 || version > stateVersion || sizeInBytes < stateHeaderSize + numValues * 4)
+        return false;
+
+    // Read everything first: a corrupt value refuses the whole state
+    // without touching anything
+    const size_t numStored = std::min(stateParameters.size(), static_cast<size_t>(numValues));
+    std::vector<float> values(numStored);
+
+    for (auto& value : values)
+    {
+        value = in.readFloat();
+
+        if (!std::isfinite(value))
+            return false;
+    }
+
+    // Only parameters whose value differs are set (and so notify the host and
+    // listeners); those an older state does not have go back to their defaults
+    for (size_t i = 0; i < stateParameters.size(); ++i)
+    {
+        auto* param = stateParameters[i];
+        const auto& range = param->getNormalisableRange();
+        const float value = i < numStored ? param->convertTo0to1(juce::jlimit(range.start, range.end, values[i]))
+                                          : param->getDefaultValue();
+
+        if (value != param->getValue())
+            param->setValueNotifyingHost(value);
+    }
+
+    return true;
+}
+
 juce::AudioProcessorValueTreeState::ParameterLayout Parameters::createParameterLayout()
 {
     juce::AudioProcessorValueTreeState::ParameterLayout layout;
@@ -69,15 +197,23 @@ juce::AudioProcessorValueTreeState::ParameterLayout Parameters::createParameterL
         juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f), 100.0f,
         juce::AudioParameterFloatAttributes().withLabel("%")));
 
+    // Version 2 appended four orderings. States store the choice index, so
+    // they recall unchanged; the version tells hosts that the normalised
+    // mapping automation uses has changed.
     layout.add(std::make_unique<juce::AudioParameterChoice>(
-        juce::ParameterID{ParamIDs::routing, 1}, "Routing",
-        juce::StringArray{"Soothe->Comp->Color", "Comp->Color->Soothe"}, 0));
+        juce::ParameterID{ParamIDs::routing, 2}, "Routing",
+        juce::StringArray{"Soothe->Comp->Color", "Comp->Color->Soothe", "Soothe->Color->Comp",
+                          "Comp->Soothe->Color", "Color->Comp->Soothe", "Color->Soothe->Comp"}, 0));
 
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         juce::ParameterID{ParamIDs::intensityMacro, 1}, "Intensity",
         juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f), 50.0f,
         juce::AudioParameterFloatAttributes().withLabel("%")));
 
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParamIDs::bypassLatency, 1}, "Bypass Latency",
+        juce::StringArray{"Constant", "Zero"}, 0));
+
     // Compressor
     layout.add(std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID{ParamIDs::compBypass, 1}, "Comp Bypass", false));
@@ -204,9 +340,22 @@ juce::AudioProcessorValueTreeState::ParameterLayout Parameters::createParameterL
     layout.add(std::make_unique<juce::AudioParameterBool>(
         juce::ParameterID{ParamIDs::sootheDelta, 1}, "Delta", false));
 
+    // Version 2 appended Live; as with routing, states keep their index
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParamIDs::sootheQuality, 2}, "Quality",
+        juce::StringArray{"Eco", "Normal", "High", "Live"}, 1));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParamIDs::sootheOverlap, 1}, "Soothe Overlap",
+        juce::StringArray{"Auto", "50%", "75%", "87.5%"}, 0));
+
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ParamIDs::sootheAnalysis, 1}, "Soothe Analysis",
+        juce::StringArray{"Linear", "ERB"}, 0));
+
     layout.add(std::make_unique<juce::AudioParameterChoice>(
-        juce::ParameterID{ParamIDs::sootheQuality, 1}, "Quality",
-        juce::StringArray{"Eco", "Normal", "High"}, 1));
+        juce::ParameterID{ParamIDs::sootheScheduling, 1}, "Soothe Scheduling",
+        juce::StringArray{"Inline", "Spread", "Worker", "Shared Pool"}, 0));
 
     return layout;
 }
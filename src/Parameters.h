@@ -1,6 +1,7 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <vector>
 
 // Parameter IDs as constants
 namespace ParamIDs
@@ -9,8 +10,9 @@ namespace ParamIDs
     inline constexpr auto inputTrim = "input_trim";
     inline constexpr auto outputTrim = "output_trim";
     inline constexpr auto globalMix = "global_mix";
-    inline constexpr auto routing = "routing";  // 0=Soothe->Comp->Color, 1=Comp->Color->Soothe
+    inline constexpr auto routing = "routing";  // Module order, see RouterModule route table
     inline constexpr auto intensityMacro = "intensity_macro";
+    inline constexpr auto bypassLatency = "bypass_latency";  // 0=Constant, 1=Drop to zero
 
     // Compressor
     inline constexpr auto compBypass = "comp_bypass";
@@ -44,7 +46,10 @@ namespace ParamIDs
     inline constexpr auto sootheFocusHigh = "soothe_focus_high";
     inline constexpr auto sootheMix = "soothe_mix";
     inline constexpr auto sootheDelta = "soothe_delta";
-    inline constexpr auto sootheQuality = "soothe_quality";  // 0=Eco, 1=Normal, 2=High
+    inline constexpr auto sootheQuality = "soothe_quality";  // 0=Eco, 1=Normal, 2=High, 3=Live (filter bank, one hop latency)
+    inline constexpr auto sootheOverlap = "soothe_overlap";  // 0=Auto (quality's hop), 1=50%, 2=75%, 3=87.5%; not used by Live
+    inline constexpr auto sootheAnalysis = "soothe_analysis";  // 0=Linear (FFT bins), 1=ERB bands
+    inline constexpr auto sootheScheduling = "soothe_scheduling";  // 0=Inline, 1=Spread, 2=Worker, 3=Shared Pool (+1 hop latency)
 }
 
 class Parameters
@@ -64,8 +69,25 @@ public:
     float getModulatedMakeup() const;
     float getModulatedDrive() const;
 
+    // Plugin state: 'MCCB', a version, then every parameter's plain value in
+    // a fixed index order. While no value has changed since the last save the
+    // previous blob is handed back as is. Any thread but the audio thread.
+    void saveState(juce::MemoryBlock& destData);
+
+    // Reads the binary format, or the APVTS XML that older versions saved
+    bool loadState(const void* data, int sizeInBytes);
+
 private:
     juce::AudioProcessorValueTreeState apvts;
 
+    // Parameters in state order (see stateLayout in Parameters.cpp)
+    std::vector<juce::RangedAudioParameter*> stateParameters;
+
+    juce::CriticalSection stateLock;
+    juce::MemoryBlock cachedState;
+    std::vector<float> cachedValues;
+
+    bool loadBinaryState(const void* data, int sizeInBytes);
+
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 };
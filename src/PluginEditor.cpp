@@ -1,5 +1,43 @@
 #include "PluginEditor.h"
 
+namespace
+{
+    // Button labels for the routing choices (S=Soothe, C=Comp, H=Harmonic color)
+    const char* const routeLabels[RouterModule::numRoutes] = {
+        "S→C→H", "C→H→S", "S→H→C", "C→S→H", "H→C→S", "H→S→C"
+    };
+
+    int getRouteIndex(const juce::RangedAudioParameter* routingParam)
+    {
+        const int route = juce::roundToInt(routingParam->convertFrom0to1(routingParam->getValue()));
+        return juce::jlimit(0, RouterModule::numRoutes - 1, route);
+    }
+
+    juce::String formatLoudness(float value)
+    {
+        return value <= LoudnessReadings::noReading ? juce::String("--.-") : juce::String(value, 1);
+    }
+
+    // Meter updates per second while the editor is visible, and while it is
+    // minimised or hidden
+    constexpr double activeUpdateHz = 30.0;
+    constexpr double backgroundUpdateHz = 4.0;
+
+    // Smallest changes worth a repaint: about a pixel of level meter, and the
+    // readouts' 0.1 resolution
+    constexpr float levelRepaintThreshold = 0.01f;
+    constexpr float grRepaintThresholdDB = 0.05f;
+
+    bool loudnessTextChanged(const LoudnessReadings& a, const LoudnessReadings& b)
+    {
+        auto changed = [](float x, float y) { return juce::roundToInt(x * 10.0f) != juce::roundToInt(y * 10.0f); };
+
+        return changed(a.momentary, b.momentary) || changed(a.shortTerm, b.shortTerm)
+            || changed(a.integrated, b.integrated) || changed(a.range, b.range)
+            || changed(a.truePeak, b.truePeak);
+    }
+}
+
 // ============================================================================
 // ModulePanel Base Class
 // ============================================================================
@@ -10,6 +48,11 @@ ModulePanel::ModulePanel(const juce::String& title, juce::Colour accentColour)
 }
 
 void ModulePanel::paint(juce::Graphics& g)
+{
+    staticLayer.draw(g, getLocalBounds(), [this](juce::Graphics& layer) { paintStaticLayer(layer); });
+}
+
+void ModulePanel::paintStaticLayer(juce::Graphics& g)
 {
     auto bounds = getLocalBounds();
 
@@ -41,7 +84,11 @@ void ModulePanel::paint(juce::Graphics& g)
 
 void ModulePanel::setBypass(bool shouldBypass)
 {
+    if (bypassed == shouldBypass)
+        return;
+
     bypassed = shouldBypass;
+    staticLayer.invalidate();
     repaint();
 }
 
@@ -115,6 +162,8 @@ CompressorPanel::CompressorPanel(MultiColorCompProcessor& p)
     mixKnob = std::make_unique<ModernKnob>("MIX", ModernLookAndFeel::cyan);
     mixKnob->setParameter(processor.getAPVTS().getParameter(ParamIDs::compMix));
     addAndMakeVisible(*mixKnob);
+
+    addAndMakeVisible(grGraph);
 }
 
 void CompressorPanel::resized()
@@ -135,8 +184,11 @@ void CompressorPanel::resized()
 
     bounds.removeFromTop(12);
 
-    // GR Meter area
+    // GR Meter area: history above the bar
     auto meterArea = bounds.removeFromTop(80);
+    grGraph.setBounds(meterArea.reduced(16).withTrimmedBottom(20));
+    meterBounds = meterArea.reduced(8);
+    barBounds = meterBounds.reduced(8).removeFromBottom(16);
     bounds.removeFromTop(12);
 
     // Knobs in 3x2 grid
@@ -154,26 +206,25 @@ void CompressorPanel::resized()
     mixKnob->setBounds(knobRow2.removeFromLeft(knobWidth).reduced(4));
 }
 
-void CompressorPanel::paint(juce::Graphics& g)
+void CompressorPanel::paintStaticLayer(juce::Graphics& g)
 {
-    ModulePanel::paint(g);
-
-    // GR Meter
-    auto bounds = getLocalBounds().reduced(12);
-    bounds.removeFromTop(40 + 28 + 12); // Skip header and buttons
-    auto meterBounds = bounds.removeFromTop(80).reduced(8);
+    ModulePanel::paintStaticLayer(g);
 
     // Meter background
     g.setColour(ModernLookAndFeel::darkBg);
     g.fillRoundedRectangle(meterBounds.toFloat(), 8.0f);
 
     // Meter bar
-    auto barBounds = meterBounds.reduced(8).removeFromBottom(16);
     g.setColour(ModernLookAndFeel::darkCard);
     g.fillRoundedRectangle(barBounds.toFloat(), 8.0f);
+}
+
+void CompressorPanel::paint(juce::Graphics& g)
+{
+    ModulePanel::paint(g);
 
     // GR indicator
-    float grAmount = std::abs(processor.getGainReduction()) / 20.0f; // Normalize to 0-1
+    float grAmount = std::abs(gainReduction) / 20.0f; // Normalize to 0-1
     if (grAmount > 0.0f)
     {
         auto grWidth = barBounds.getWidth() * juce::jmin(grAmount, 1.0f);
@@ -183,11 +234,33 @@ void CompressorPanel::paint(juce::Graphics& g)
     }
 
     // GR text
-    g.setColour(ModernLookAndFeel::cyan);
+    g.setColour(ModernLookAndFeel::textPrimary);
     g.setFont(juce::Font(10.0f, juce::Font::plain));
-    auto textBounds = meterBounds.reduced(8);
-    g.drawText(juce::String::formatted("GR: %.1f dB", processor.getGainReduction()),
-               textBounds, juce::Justification::centred);
+    g.drawText(juce::String::formatted("GR: %.1f dB", gainReduction),
+               barBounds, juce::Justification::centred);
+}
+
+void CompressorPanel::setGainReduction(float grDB)
+{
+    // GR too small to see reads as none, so the bar always settles at 0 dB;
+    // beyond that, small steps are invisible
+    if (std::abs(grDB) < grRepaintThresholdDB)
+        grDB = 0.0f;
+
+    if (grDB == gainReduction || (grDB != 0.0f && std::abs(grDB - gainReduction) < grRepaintThresholdDB))
+        return;
+
+    gainReduction = grDB;
+    repaint(barBounds);
+}
+
+void CompressorPanel::updateHistory(GainReductionHistory& history)
+{
+    GainReductionPoint point;
+    while (history.pop(point))
+        grGraph.addPoint(point);
+
+    grGraph.flush();
 }
 
 void CompressorPanel::updateButtonStates()
@@ -299,9 +372,9 @@ void ColorPanel::resized()
     mixKnob->setBounds(knobRow.removeFromLeft(knobWidth).reduced(4));
 }
 
-void ColorPanel::paint(juce::Graphics& g)
+void ColorPanel::paintStaticLayer(juce::Graphics& g)
 {
-    ModulePanel::paint(g);
+    ModulePanel::paintStaticLayer(g);
 
     // Saturation curve visual
     auto bounds = getLocalBounds().reduced(12);
@@ -378,7 +451,7 @@ void SoothePanel::resized()
     bounds.removeFromTop(40);
 
     // Spectral display area
-    bounds.removeFromTop(120);
+    spectrumBounds = bounds.removeFromTop(120).reduced(8);
     bounds.removeFromTop(12);
 
     // Knobs in 3x2 grid
@@ -396,15 +469,11 @@ void SoothePanel::resized()
     focusHighKnob->setBounds(knobRow2.removeFromLeft(knobWidth).reduced(4));
 }
 
-void SoothePanel::paint(juce::Graphics& g)
+void SoothePanel::paintStaticLayer(juce::Graphics& g)
 {
-    ModulePanel::paint(g);
+    ModulePanel::paintStaticLayer(g);
 
     // Spectral display
-    auto bounds = getLocalBounds().reduced(12);
-    bounds.removeFromTop(40);
-    auto spectrumBounds = bounds.removeFromTop(120).reduced(8);
-
     g.setColour(ModernLookAndFeel::darkBg);
     g.fillRoundedRectangle(spectrumBounds.toFloat(), 8.0f);
 
@@ -424,11 +493,91 @@ void SoothePanel::paint(juce::Graphics& g)
     // Frequency labels
     g.setColour(ModernLookAndFeel::textSecondary);
     g.setFont(juce::Font(8.0f));
-    auto labelBounds = spectrumBounds.removeFromBottom(12);
+    auto labelBounds = spectrumBounds.withTop(spectrumBounds.getBottom() - 12);
     g.drawText("20Hz", labelBounds.removeFromLeft(40), juce::Justification::centredLeft);
     g.drawText("20kHz", labelBounds.removeFromRight(40), juce::Justification::centredRight);
 }
 
+void SoothePanel::paint(juce::Graphics& g)
+{
+    ModulePanel::paint(g);
+
+    if (hasDisplayFrame)
+        paintSpectrum(g, spectrumBounds.toFloat().reduced(4.0f));
+}
+
+void SoothePanel::setDisplayFrame(const SootheDisplayFrame& frame)
+{
+    // Silence publishes the same frame over and over
+    if (hasDisplayFrame && frame.hasBaseline == displayFrame.hasBaseline && frame.magnitude == displayFrame.magnitude
+        && frame.baseline == displayFrame.baseline && frame.attenuation == displayFrame.attenuation)
+        return;
+
+    displayFrame = frame;
+    hasDisplayFrame = true;
+    repaint(spectrumBounds);
+}
+
+void SoothePanel::paintSpectrum(juce::Graphics& g, juce::Rectangle<float> area) const
+{
+    // Spectrum and baseline over 90 dB; the reduction hangs from the top,
+    // its full 12 dB reaching halfway down
+    constexpr float floorDB = -90.0f;
+    constexpr float maxReductionDB = 12.0f;
+    constexpr int numPoints = SootheDisplayFrame::numPoints;
+    const float step = area.getWidth() / static_cast<float>(numPoints - 1);
+
+    auto levelToY = [&area](float gain) {
+        return juce::jmap(juce::Decibels::gainToDecibels(gain, floorDB), floorDB, 0.0f, area.getBottom(), area.getY());
+    };
+
+    juce::Path spectrum, baseline, reduction;
+    spectrum.startNewSubPath(area.getBottomLeft());
+
+    for (size_t p = 0; p < static_cast<size_t>(numPoints); ++p)
+    {
+        const float x = area.getX() + step * static_cast<float>(p);
+        spectrum.lineTo(x, levelToY(displayFrame.magnitude[p]));
+
+        const float baselineY = levelToY(displayFrame.baseline[p]);
+        const float reductionDB = -juce::Decibels::gainToDecibels(displayFrame.attenuation[p], -maxReductionDB);
+        const float reductionY = area.getY() + area.getHeight() * 0.5f * reductionDB / maxReductionDB;
+
+        if (p == 0)
+        {
+            baseline.startNewSubPath(x, baselineY);
+            reduction.startNewSubPath(x, reductionY);
+        }
+        else
+        {
+            baseline.lineTo(x, baselineY);
+            reduction.lineTo(x, reductionY);
+        }
+    }
+
+    spectrum.lineTo(area.getBottomRight());
+    spectrum.closeSubPath();
+
+    g.setColour(ModernLookAndFeel::textSecondary.withAlpha(0.25f));
+    g.fillPath(spectrum);
+
+    if (displayFrame.hasBaseline)
+    {
+        g.setColour(ModernLookAndFeel::textSecondary.withAlpha(0.6f));
+        g.strokePath(baseline, juce::PathStrokeType(1.0f));
+    }
+
+    auto reductionFill = reduction;
+    reductionFill.lineTo(area.getTopRight());
+    reductionFill.lineTo(area.getTopLeft());
+    reductionFill.closeSubPath();
+
+    g.setColour(ModernLookAndFeel::fuchsia.withAlpha(0.3f));
+    g.fillPath(reductionFill);
+    g.setColour(ModernLookAndFeel::fuchsia);
+    g.strokePath(reduction, juce::PathStrokeType(1.5f));
+}
+
 // ============================================================================
 // MultiColorCompEditor
 // ============================================================================
@@ -436,7 +585,8 @@ void SoothePanel::paint(juce::Graphics& g)
 MultiColorCompEditor::MultiColorCompEditor(MultiColorCompProcessor& p)
     : AudioProcessorEditor(&p), processor(p),
       compressorPanel(p), colorPanel(p), soothePanel(p),
-      intensityKnob("", ModernLookAndFeel::emerald)
+      intensityKnob("", ModernLookAndFeel::emerald),
+      performanceOverlay(p.getProfiler())
 {
     setLookAndFeel(&modernLNF);
 
@@ -447,30 +597,38 @@ MultiColorCompEditor::MultiColorCompEditor(MultiColorCompProcessor& p)
     auto* routingParam = processor.getAPVTS().getParameter(ParamIDs::routing);
     routingButton.setColour(juce::TextButton::buttonColourId, ModernLookAndFeel::darkCard);
     routingButton.onClick = [this, routingParam]() {
-        float currentValue = routingParam->getValue();
-        float newValue = (currentValue < 0.5f) ? 1.0f : 0.0f;
-        routingParam->setValueNotifyingHost(newValue);
-        routingButton.setButtonText(newValue < 0.5f ? "S→C→H" : "C→H→S");
+        // Cycle through every module order
+        const int newRoute = (getRouteIndex(routingParam) + 1) % RouterModule::numRoutes;
+        routingParam->setValueNotifyingHost(routingParam->convertTo0to1(static_cast<float>(newRoute)));
+        routingButton.setButtonText(routeLabels[newRoute]);
     };
 
     // Set initial routing button text
-    routingButton.setButtonText(routingParam->getValue() < 0.5f ? "S→C→H" : "C→H→S");
+    routingButton.setButtonText(routeLabels[getRouteIndex(routingParam)]);
     addAndMakeVisible(routingButton);
 
     addAndMakeVisible(compressorPanel);
     addAndMakeVisible(colorPanel);
     addAndMakeVisible(soothePanel);
 
+    // On top of the panels, hidden until asked for
+    addChildComponent(performanceOverlay);
+
     setSize(1200, 700);
     setResizable(true, true);
     setResizeLimits(1000, 600, 1600, 1000);
 
-    startTimerHz(30);
+    // Soothe only decimates and publishes its curves, and the compressor only
+    // feeds its GR history, while this is open
+    processor.getSootheDisplay().setEnabled(true);
+    processor.getGainReductionHistory().setEnabled(true);
 }
 
 MultiColorCompEditor::~MultiColorCompEditor()
 {
-    stopTimer();
+    processor.getProfiler().setEnabled(false);
+    processor.getSootheDisplay().setEnabled(false);
+    processor.getGainReductionHistory().setEnabled(false);
     setLookAndFeel(nullptr);
 }
 
@@ -478,50 +636,99 @@ void MultiColorCompEditor::paint(juce::Graphics& g)
 {
     g.fillAll(ModernLookAndFeel::darkBg);
 
-    auto bounds = getLocalBounds();
+    topBarLayer.draw(g, topBarArea, [this](juce::Graphics& layer) { paintTopBar(layer); });
+    bottomBarLayer.draw(g, bottomBarArea, [this](juce::Graphics& layer) {
+        layer.addTransform(juce::AffineTransform::translation(-bottomBarArea.getPosition().toFloat()));
+        paintBottomBar(layer);
+    });
 
-    // Top bar
-    auto topBar = bounds.removeFromTop(64);
+    // Input/Output meters
+    g.setColour(juce::Colour(0xff34d399).withAlpha(0.7f));
+    g.fillRoundedRectangle(inputMeterArea.toFloat().removeFromLeft(inputMeterArea.getWidth() * juce::jmin(inputLevel, 1.0f)), 4.0f);
+    g.fillRoundedRectangle(outputMeterArea.toFloat().removeFromLeft(outputMeterArea.getWidth() * juce::jmin(outputLevel, 1.0f)), 4.0f);
+
+    paintLoudness(g);
+}
+
+void MultiColorCompEditor::paintTopBar(juce::Graphics& g)
+{
+    auto topBar = topBarArea;
     g.setColour(ModernLookAndFeel::darkPanel);
     g.fillRect(topBar);
 
     g.setColour(ModernLookAndFeel::textPrimary);
     g.setFont(juce::Font(18.0f, juce::Font::bold));
-    auto titleArea = topBar.removeFromLeft(200).reduced(16, 0);
-    g.drawText("MULTI-COLOR", titleArea, juce::Justification::centredLeft);
+    auto titleTextArea = topBar.removeFromLeft(200).reduced(16, 0);
+    g.drawText("MULTI-COLOR", titleTextArea, juce::Justification::centredLeft);
 
     g.setColour(ModernLookAndFeel::cyan);
     auto compArea = topBar.removeFromLeft(100);
     g.drawText("COMP", compArea, juce::Justification::centredLeft);
+}
 
-    // Bottom bar
-    auto bottomBar = bounds.removeFromBottom(48);
+void MultiColorCompEditor::paintBottomBar(juce::Graphics& g)
+{
     g.setColour(juce::Colour(0xff0a0f1a));
-    g.fillRect(bottomBar);
+    g.fillRect(bottomBarArea);
 
-    // Input/Output meters
-    auto meterArea = bottomBar.reduced(16);
+    // Meter labels and tracks
+    auto meterArea = bottomBarArea.reduced(16);
     g.setColour(ModernLookAndFeel::textSecondary);
     g.setFont(juce::Font(9.0f));
     g.drawText("INPUT", meterArea.removeFromLeft(50), juce::Justification::centredLeft);
+    meterArea.removeFromLeft(100 + 30);
+    g.drawText("OUTPUT", meterArea.removeFromLeft(50), juce::Justification::centredLeft);
 
-    auto inputMeter = meterArea.removeFromLeft(100).reduced(0, 16);
     g.setColour(ModernLookAndFeel::darkCard);
-    g.fillRoundedRectangle(inputMeter.toFloat(), 4.0f);
-    float inputLevel = (inputLevelL + inputLevelR) * 0.5f;
-    g.setColour(juce::Colour(0xff34d399).withAlpha(0.7f));
-    g.fillRoundedRectangle(inputMeter.toFloat().removeFromLeft(inputMeter.getWidth() * juce::jmin(inputLevel, 1.0f)), 4.0f);
+    g.fillRoundedRectangle(inputMeterArea.toFloat(), 4.0f);
+    g.fillRoundedRectangle(outputMeterArea.toFloat(), 4.0f);
+}
 
-    meterArea.removeFromLeft(30);
-    g.setColour(ModernLookAndFeel::textSecondary);
-    g.drawText("OUTPUT", meterArea.removeFromLeft(50), juce::Justification::centredLeft);
+void MultiColorCompEditor::paintLoudness(juce::Graphics& g)
+{
+    auto area = loudnessArea;
+    g.setFont(juce::Font(10.0f));
+
+    auto drawRow = [&g](juce::Rectangle<int> row, const juce::String& label, const LoudnessReadings& r) {
+        g.setColour(ModernLookAndFeel::textSecondary);
+        g.drawText(label, row.removeFromLeft(32), juce::Justification::centredLeft);
+
+        g.setColour(ModernLookAndFeel::textPrimary);
+        g.drawText("M " + formatLoudness(r.momentary)
+                       + "   S " + formatLoudness(r.shortTerm)
+                       + "   I " + formatLoudness(r.integrated) + " LUFS"
+                       + "   LRA " + juce::String(r.range, 1) + " LU"
+                       + "   TP " + formatLoudness(r.truePeak) + " dBTP",
+                   row, juce::Justification::centredLeft);
+    };
 
-    auto outputMeter = meterArea.removeFromLeft(100).reduced(0, 16);
-    g.setColour(ModernLookAndFeel::darkCard);
-    g.fillRoundedRectangle(outputMeter.toFloat(), 4.0f);
-    float outputLevel = (outputLevelL + outputLevelR) * 0.5f;
-    g.setColour(juce::Colour(0xff34d399).withAlpha(0.7f));
-    g.fillRoundedRectangle(outputMeter.toFloat().removeFromLeft(outputMeter.getWidth() * juce::jmin(outputLevel, 1.0f)), 4.0f);
+    drawRow(area.removeFromTop(area.getHeight() / 2), "IN", shownInputLoudness);
+    drawRow(area, "OUT", shownOutputLoudness);
+}
+
+void MultiColorCompEditor::mouseDown(const juce::MouseEvent& event)
+{
+    if (loudnessArea.contains(event.getPosition()))
+        processor.resetLoudness();
+}
+
+void MultiColorCompEditor::mouseDoubleClick(const juce::MouseEvent& event)
+{
+    if (!titleArea.contains(event.getPosition()))
+        return;
+
+    // Profiling only costs anything while the overlay is up
+    const bool show = !performanceOverlay.isVisible();
+    auto& profiler = processor.getProfiler();
+
+    if (show)
+    {
+        profiler.resetPeaks();
+        performanceOverlay.resetEditorStats();
+    }
+
+    profiler.setEnabled(show);
+    performanceOverlay.setVisible(show);
 }
 
 void MultiColorCompEditor::resized()
@@ -529,8 +736,9 @@ void MultiColorCompEditor::resized()
     auto bounds = getLocalBounds();
 
     // Top bar
-    auto topBar = bounds.removeFromTop(64);
-    topBar.removeFromLeft(320); // Skip title area
+    topBarArea = bounds.removeFromTop(64);
+    auto topBar = topBarArea;
+    titleArea = topBar.removeFromLeft(320);
 
     // Intensity knob in top bar
     intensityKnob.setBounds(topBar.removeFromRight(90).reduced(8));
@@ -538,8 +746,17 @@ void MultiColorCompEditor::resized()
     // Routing button
     routingButton.setBounds(topBar.removeFromRight(120).reduced(8, 16));
 
-    // Bottom bar
-    bounds.removeFromBottom(48);
+    // Bottom bar (meters on the left, loudness readout on the right)
+    bottomBarArea = bounds.removeFromBottom(48);
+    loudnessArea = bottomBarArea.withTrimmedLeft(bottomBarArea.getWidth() - 440).reduced(16, 6);
+
+    auto meterArea = bottomBarArea.reduced(16);
+    meterArea.removeFromLeft(50);
+    inputMeterArea = meterArea.removeFromLeft(100).reduced(0, 16);
+    meterArea.removeFromLeft(30 + 50);
+    outputMeterArea = meterArea.removeFromLeft(100).reduced(0, 16);
+
+    performanceOverlay.setBounds(bounds.getRight() - 296, bounds.getY() + 8, 280, 140);
 
     // Module panels
     bounds.reduce(16, 16);
@@ -552,22 +769,81 @@ void MultiColorCompEditor::resized()
     soothePanel.setBounds(bounds);
 }
 
-void MultiColorCompEditor::timerCallback()
+bool MultiColorCompEditor::isInBackground() const
+{
+    // Only states that really hide the editor: a host that is merely not the
+    // frontmost process may still be in plain view (a second monitor, say)
+    const auto* peer = getPeer();
+    return peer == nullptr || peer->isMinimised() || !isShowing();
+}
+
+void MultiColorCompEditor::onVBlank()
 {
-    inputLevelL = processor.getInputLevel(0);
-    inputLevelR = processor.getInputLevel(1);
-    outputLevelL = processor.getOutputLevel(0);
-    outputLevelR = processor.getOutputLevel(1);
-    grLevel = processor.getGainReduction();
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+    const double intervalMs = 1000.0 / (isInBackground() ? backgroundUpdateHz : activeUpdateHz);
 
-    // Update button states (for automation)
+    // A little early is fine: refresh periods rarely divide the interval evenly
+    if (nowMs - lastUpdateMs < intervalMs * 0.9)
+        return;
+
+    const double elapsedMs = nowMs - lastUpdateMs;
+    lastUpdateMs = nowMs;
+
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    updateMeters();
+
+    if (performanceOverlay.isVisible())
+    {
+        const auto ticks = juce::Time::getHighResolutionTicks() - startTicks;
+        performanceOverlay.addEditorUpdate(juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6, elapsedMs * 0.001);
+        performanceOverlay.update();
+    }
+}
+
+void MultiColorCompEditor::updateMeters()
+{
+    // Drain every block's readings and apply ballistics here, off the audio thread
+    MeterFrame frame;
+    while (processor.getMeterFifo().pop(frame))
+        meters.addFrame(frame);
+
+    // Only what visibly changed is repainted
+    const float newInputLevel = (meters.getInputRMS(0) + meters.getInputRMS(1)) * 0.5f;
+    const float newOutputLevel = (meters.getOutputRMS(0) + meters.getOutputRMS(1)) * 0.5f;
+
+    if (std::abs(newInputLevel - inputLevel) >= levelRepaintThreshold)
+    {
+        inputLevel = newInputLevel;
+        repaint(inputMeterArea);
+    }
+
+    if (std::abs(newOutputLevel - outputLevel) >= levelRepaintThreshold)
+    {
+        outputLevel = newOutputLevel;
+        repaint(outputMeterArea);
+    }
+
+    const auto& inputLoudness = meters.getInputLoudness();
+    const auto& outputLoudness = meters.getOutputLoudness();
+
+    if (loudnessTextChanged(inputLoudness, shownInputLoudness) || loudnessTextChanged(outputLoudness, shownOutputLoudness))
+    {
+        shownInputLoudness = inputLoudness;
+        shownOutputLoudness = outputLoudness;
+        repaint(loudnessArea);
+    }
+
+    compressorPanel.setGainReduction(meters.getGainReduction());
+    compressorPanel.updateHistory(processor.getGainReductionHistory());
+
+    auto& sootheFrames = processor.getSootheDisplay().getFrames();
+    if (sootheFrames.fetch())
+        soothePanel.setDisplayFrame(sootheFrames.getReadBuffer());
+
+    // Update button states (for automation); these repaint only on a change
     compressorPanel.updateButtonStates();
     colorPanel.updateButtonStates();
 
-    // Update routing button text
     auto* routingParam = processor.getAPVTS().getParameter(ParamIDs::routing);
-    routingButton.setButtonText(routingParam->getValue() < 0.5f ? "S→C→H" : "C→H→S");
-
-    compressorPanel.repaint();
-    repaint();
+    routingButton.setButtonText(routeLabels[getRouteIndex(routingParam)]);
 }
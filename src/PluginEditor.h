@@ -5,6 +5,10 @@
 #include "PluginProcessor.h"
 #include "ui/ModernLookAndFeel.h"
 #include "ui/ModernKnob.h"
+#include "ui/MeterBallistics.h"
+#include "ui/PerformanceOverlay.h"
+#include "ui/GainReductionGraph.h"
+#include "ui/CachedLayer.h"
 
 class ModulePanel : public juce::Component
 {
@@ -15,9 +19,17 @@ public:
     bool isBypassed() const { return bypassed; }
 
 protected:
+    // Background, header and any fixed artwork: rendered into an image that is
+    // only redrawn on resize, scale change or bypass. paint() overrides draw
+    // the moving parts on top.
+    virtual void paintStaticLayer(juce::Graphics& g);
+
     juce::String moduleTitle;
     juce::Colour colour;
     bool bypassed = false;
+
+private:
+    CachedLayer staticLayer;
 };
 
 class CompressorPanel : public ModulePanel
@@ -27,9 +39,18 @@ public:
     void resized() override;
     void paint(juce::Graphics& g) override;
     void updateButtonStates();
+    void setGainReduction(float grDB);
+
+    // Drains the compressor's GR points into the scrolling graph
+    void updateHistory(GainReductionHistory& history);
 
 private:
+    void paintStaticLayer(juce::Graphics& g) override;
+
     MultiColorCompProcessor& processor;
+    float gainReduction = 0.0f;
+    juce::Rectangle<int> meterBounds, barBounds;
+    GainReductionGraph grGraph{ModernLookAndFeel::cyan};
     std::unique_ptr<ModernKnob> thresholdKnob, ratioKnob, attackKnob, releaseKnob, kneeKnob, mixKnob;
     juce::TextButton vcaButton, fetButton, optoButton, varimuButton;
     std::unique_ptr<juce::ButtonParameterAttachment> styleAttachment;
@@ -42,10 +63,11 @@ class ColorPanel : public ModulePanel
 public:
     ColorPanel(MultiColorCompProcessor& p);
     void resized() override;
-    void paint(juce::Graphics& g) override;
     void updateButtonStates();
 
 private:
+    void paintStaticLayer(juce::Graphics& g) override;
+
     MultiColorCompProcessor& processor;
     std::unique_ptr<ModernKnob> driveKnob, toneKnob, mixKnob, outputKnob;
     juce::TextButton tapeButton, tubeButton, transButton, clipButton;
@@ -60,16 +82,23 @@ public:
     SoothePanel(MultiColorCompProcessor& p);
     void resized() override;
     void paint(juce::Graphics& g) override;
+    void setDisplayFrame(const SootheDisplayFrame& frame);
 
 private:
+    void paintStaticLayer(juce::Graphics& g) override;
+    void paintSpectrum(juce::Graphics& g, juce::Rectangle<float> area) const;
+
     MultiColorCompProcessor& processor;
+    juce::Rectangle<int> spectrumBounds;
+    SootheDisplayFrame displayFrame;
+    bool hasDisplayFrame = false;
     std::unique_ptr<ModernKnob> amountKnob, sensitivityKnob, sharpnessKnob;
     std::unique_ptr<ModernKnob> speedKnob, focusLowKnob, focusHighKnob;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SoothePanel)
 };
 
-class MultiColorCompEditor : public juce::AudioProcessorEditor, private juce::Timer
+class MultiColorCompEditor : public juce::AudioProcessorEditor
 {
 public:
     explicit MultiColorCompEditor(MultiColorCompProcessor&);
@@ -77,9 +106,19 @@ public:
 
     void paint(juce::Graphics&) override;
     void resized() override;
+    void mouseDown(const juce::MouseEvent& event) override;
+    void mouseDoubleClick(const juce::MouseEvent& event) override;
 
 private:
-    void timerCallback() override;
+    // Called on every display refresh; does the meter work at most at the
+    // active rate, or the background rate while minimised or hidden
+    void onVBlank();
+    void updateMeters();
+    bool isInBackground() const;
+
+    void paintTopBar(juce::Graphics& g);
+    void paintBottomBar(juce::Graphics& g);
+    void paintLoudness(juce::Graphics& g);
 
     MultiColorCompProcessor& processor;
     ModernLookAndFeel modernLNF;
@@ -92,9 +131,25 @@ private:
     juce::TextButton routingButton;
 
     // Metering
-    float inputLevelL = 0.0f, inputLevelR = 0.0f;
-    float outputLevelL = 0.0f, outputLevelR = 0.0f;
-    float grLevel = 0.0f;
+    MeterBallistics meters;
+    float inputLevel = 0.0f;
+    float outputLevel = 0.0f;
+    LoudnessReadings shownInputLoudness, shownOutputLoudness;
+
+    // The bars are cached; only the meters and readout are repainted per tick
+    juce::Rectangle<int> topBarArea, bottomBarArea;
+    juce::Rectangle<int> inputMeterArea, outputMeterArea;
+    CachedLayer topBarLayer, bottomBarLayer;
+
+    // Loudness readout in the bottom bar (click to reset)
+    juce::Rectangle<int> loudnessArea;
+
+    // Double-clicking the title shows the CPU overlay
+    juce::Rectangle<int> titleArea;
+    PerformanceOverlay performanceOverlay;
+
+    double lastUpdateMs = 0.0;
+    juce::VBlankAttachment vBlankAttachment{this, [this] { onVBlank(); }};
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultiColorCompEditor)
 };
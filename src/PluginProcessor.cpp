@@ -2,10 +2,7 @@
 #include "PluginEditor.h"
 
 MultiColorCompProcessor::MultiColorCompProcessor()
-    : AudioProcessor(BusesProperties()
-                         .withInput("Input", juce::AudioChannelSet::stereo(), true)
-                         .withOutput("Output", juce::AudioChannelSet::stereo(), true)),
-      parameters(*this)
+    : ChainProcessor(LatencyReporting::MessageThread)
 {
 }
 
@@ -15,56 +12,22 @@ MultiColorCompProcessor::~MultiColorCompProcessor()
 
 void MultiColorCompProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = static_cast<juce::uint32>(samplesPerBlock);
-    spec.numChannels = static_cast<juce::uint32>(getTotalNumOutputChannels());
-
-    router.prepare(spec);
+    ChainProcessor::prepareToPlay(sampleRate, samplesPerBlock);
+    meterFramePending = false;
 }
 
-void MultiColorCompProcessor::releaseResources()
+void MultiColorCompProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
 {
-    router.reset();
-}
+    ChainProcessor::processBlock(buffer, midi);
 
-bool MultiColorCompProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
-{
-    // Support mono and stereo
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-        && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
+    // Levels were gathered inside the router's own passes
+    if (meterFramePending)
+        pendingMeterFrame.merge(router.getMeterFrame());
+    else
+        pendingMeterFrame = router.getMeterFrame();
 
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-
-    return true;
-}
-
-void MultiColorCompProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
-{
-    juce::ScopedNoDenormals noDenormals;
-
-    // Input metering
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        inputLevel[ch].store(buffer.getRMSLevel(ch, 0, buffer.getNumSamples()));
-    }
-
-    // Process audio through router
-    juce::dsp::AudioBlock<float> block(buffer);
-    juce::dsp::ProcessContextReplacing<float> context(block);
-
-    router.process(context, parameters);
-
-    // Get gain reduction for metering
-    gainReduction.store(router.getGainReduction());
-
-    // Output metering
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        outputLevel[ch].store(buffer.getRMSLevel(ch, 0, buffer.getNumSamples()));
-    }
+    meterFramePending = pendingMeterFrame.durationSeconds < minMeterFrameSeconds
+                        || !meterFifo.push(pendingMeterFrame);
 }
 
 juce::AudioProcessorEditor* MultiColorCompProcessor::createEditor()
@@ -72,26 +35,6 @@ juce::AudioProcessorEditor* MultiColorCompProcessor::createEditor()
     return new MultiColorCompEditor(*this);
 }
 
-void MultiColorCompProcessor::getStateInformation(juce::MemoryBlock& destData)
-{
-    auto state = parameters.getAPVTS().copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
-}
-
-void MultiColorCompProcessor::setStateInformation(const void* data, int sizeInBytes)
-{
-    std::unique_ptr<juce::XmlElement> xmlState(getXmlFromBinary(data, sizeInBytes));
-
-    if (xmlState.get() != nullptr)
-    {
-        if (xmlState->hasTagName(parameters.getAPVTS().state.getType()))
-        {
-            parameters.getAPVTS().replaceState(juce::ValueTree::fromXml(*xmlState));
-        }
-    }
-}
-
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
     return new MultiColorCompProcessor();
@@ -1,4 +1,5 @@
 #include "ColorModule.h"
+#include "TraceRecorder.h"
 #include <cmath>
 
 ColorModule::ColorModule()
@@ -57,6 +58,11 @@ void ColorModule::process(juce::dsp::AudioBlock<float>& block, const Parameters&
     if (params.getBoolValue(ParamIDs::colorBypass))
         return;
 
+    processActive(block, params);
+}
+
+void ColorModule::processActive(juce::dsp::AudioBlock<float>& block, const Parameters& params)
+{
     const int numChannels = static_cast<int>(block.getNumChannels());
     const int numSamples = static_cast<int>(block.getNumSamples());
 
@@ -85,16 +91,19 @@ void ColorModule::process(juce::dsp::AudioBlock<float>& block, const Parameters&
 
     if (osMode == 2 || (osMode == 0 && drive > 0.5f))  // 2x
     {
+        MCC_TRACE_SCOPE("Oversample up");
         oversampledBlock = oversampling2x->processSamplesUp(block);
         processBlock = &oversampledBlock;
     }
     else if (osMode == 3 || (osMode == 0 && drive > 0.7f))  // 4x
     {
+        MCC_TRACE_SCOPE("Oversample up");
         oversampledBlock = oversampling4x->processSamplesUp(block);
         processBlock = &oversampledBlock;
     }
     else if (osMode == 4)  // 8x
     {
+        MCC_TRACE_SCOPE("Oversample up");
         oversampledBlock = oversampling8x->processSamplesUp(block);
         processBlock = &oversampledBlock;
     }
@@ -138,6 +147,8 @@ void ColorModule::process(juce::dsp::AudioBlock<float>& block, const Parameters&
     // Downsample if needed
     if (osMode >= 2 || (osMode == 0 && drive > 0.5f))
     {
+        MCC_TRACE_SCOPE("Oversample down");
+
         if (osMode == 2 || (osMode == 0 && drive <= 0.7f))
             oversampling2x->processSamplesDown(block);
         else if (osMode == 3)
@@ -163,6 +174,29 @@ void ColorModule::process(juce::dsp::AudioBlock<float>& block, const Parameters&
     }
 }
 
+void ColorModule::copyStateFrom(const ColorModule& other)
+{
+    driveSmoother = other.driveSmoother;
+    toneSmoother = other.toneSmoother;
+    mixSmoother = other.mixSmoother;
+    outputSmoother = other.outputSmoother;
+
+    for (int ch = 0; ch < 2; ++ch)
+        dcBlockerState[ch] = other.dcBlockerState[ch];
+
+    // Oversampling filter state can't be copied; start those clean
+    oversampling2x->reset();
+    oversampling4x->reset();
+    oversampling8x->reset();
+}
+
+int ColorModule::getTailSamples() const
+{
+    // Oversampler ringing (a few group delays) plus the DC blocker decay (0.995 pole, ~1000 samples to -45 dB)
+    const float osLatency = oversampling8x != nullptr ? oversampling8x->getLatencyInSamples() : 0.0f;
+    return static_cast<int>(std::ceil(osLatency)) * 4 + 1000;
+}
+
 float ColorModule::processTape(float input, float drive)
 {
     // Soft tape saturation
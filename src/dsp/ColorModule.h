@@ -18,6 +18,14 @@ public:
     void reset();
     void process(juce::dsp::AudioBlock<float>& block, const Parameters& params);
 
+    // Processes regardless of the bypass parameter (bypass handled by the router)
+    void processActive(juce::dsp::AudioBlock<float>& block, const Parameters& params);
+
+    // Takes over another instance's smoother and DC blocker state
+    void copyStateFrom(const ColorModule& other);
+
+    int getTailSamples() const;
+
     enum ColorType
     {
         Tape = 0,
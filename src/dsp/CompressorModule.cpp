@@ -1,5 +1,6 @@
 #include "CompressorModule.h"
 #include <cmath>
+#include <limits>
 
 CompressorModule::CompressorModule()
 {
@@ -48,6 +49,8 @@ void CompressorModule::reset()
         s.reset();
 
     currentGR = 0.0f;
+    blockGRMin = 0.0f;
+    blockGRMax = 0.0f;
 }
 
 void CompressorModule::process(juce::dsp::AudioBlock<float>& block, const Parameters& params)
@@ -55,6 +58,11 @@ void CompressorModule::process(juce::dsp::AudioBlock<float>& block, const Parame
     if (params.getBoolValue(ParamIDs::compBypass))
         return;
 
+    processActive(block, params);
+}
+
+void CompressorModule::processActive(juce::dsp::AudioBlock<float>& block, const Parameters& params)
+{
     const int numChannels = static_cast<int>(block.getNumChannels());
     const int numSamples = static_cast<int>(block.getNumSamples());
 
@@ -89,6 +97,10 @@ void CompressorModule::process(juce::dsp::AudioBlock<float>& block, const Parame
     mixSmoother.setTarget(mix);
     hpfFreqSmoother.setTarget(hpfFreq);
 
+    // GR extremes for metering, tracked in the main loop
+    float grMin = std::numeric_limits<float>::max();
+    float grMax = std::numeric_limits<float>::lowest();
+
     for (int i = 0; i < numSamples; ++i)
     {
         // Get smoothed parameters
@@ -103,10 +115,12 @@ void CompressorModule::process(juce::dsp::AudioBlock<float>& block, const Parame
 
         // Compute detector level for each channel
         float detectorLevels[2] = {-100.0f, -100.0f};
+        float inputPeak = 0.0f;
 
         for (int ch = 0; ch < numChannels; ++ch)
         {
             float sample = block.getSample(ch, i);
+            inputPeak = std::max(inputPeak, std::abs(sample));
 
             // Sidechain HPF
             sample = processSidechainHPF(sample, state[ch].hpfState, hpf);
@@ -148,9 +162,69 @@ void CompressorModule::process(juce::dsp::AudioBlock<float>& block, const Parame
 
         // Store GR for metering (use first channel)
         currentGR = grDB;
+        grMin = std::min(grMin, grDB);
+        grMax = std::max(grMax, grDB);
+
+        if (history != nullptr)
+            history->addSample(grDB, inputPeak);
+    }
+
+    if (numSamples > 0)
+    {
+        blockGRMin = grMin;
+        blockGRMax = grMax;
     }
 }
 
+void CompressorModule::addBypassedToHistory(const juce::dsp::AudioBlock<float>& block)
+{
+    if (history == nullptr)
+        return;
+
+    const int numChannels = std::min(2, static_cast<int>(block.getNumChannels()));
+    const int numSamples = static_cast<int>(block.getNumSamples());
+
+    // Same peak as processActive() feeds: across channels, before anything else
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float inputPeak = 0.0f;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            inputPeak = std::max(inputPeak, std::abs(block.getSample(ch, i)));
+
+        history->addSample(0.0f, inputPeak);
+    }
+}
+
+void CompressorModule::copyStateFrom(const CompressorModule& other)
+{
+    for (int ch = 0; ch < 2; ++ch)
+        state[ch] = other.state[ch];
+
+    attackSmoother = other.attackSmoother;
+    releaseSmoother = other.releaseSmoother;
+    thresholdSmoother = other.thresholdSmoother;
+    ratioSmoother = other.ratioSmoother;
+    kneeSmoother = other.kneeSmoother;
+    makeupSmoother = other.makeupSmoother;
+    mixSmoother = other.mixSmoother;
+    hpfFreqSmoother = other.hpfFreqSmoother;
+
+    styleCrossfade = other.styleCrossfade;
+    previousStyle = other.previousStyle;
+    currentStyle = other.currentStyle;
+    currentGR = other.currentGR;
+    blockGRMin = other.blockGRMin;
+    blockGRMax = other.blockGRMax;
+}
+
+int CompressorModule::getTailSamples() const
+{
+    // Five release time constants: the detector has settled to within ~-45 dB
+    const float releaseMs = releaseSmoother.getCurrentValue();
+    return static_cast<int>(5.0f * releaseMs * 0.001f * static_cast<float>(sampleRate));
+}
+
 float CompressorModule::processSidechainHPF(float input, float& hpfState, float freq)
 {
     // Simple one-pole HPF
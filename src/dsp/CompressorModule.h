@@ -3,6 +3,7 @@
 #include <juce_dsp/juce_dsp.h>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "Smoothing.h"
+#include "GainReductionHistory.h"
 #include "../Parameters.h"
 
 /**
@@ -21,8 +22,25 @@ public:
     void reset();
     void process(juce::dsp::AudioBlock<float>& block, const Parameters& params);
 
+    // Processes regardless of the bypass parameter (bypass handled by the router)
+    void processActive(juce::dsp::AudioBlock<float>& block, const Parameters& params);
+
+    // Takes over another instance's envelopes and smoother positions
+    void copyStateFrom(const CompressorModule& other);
+
     float getGainReduction() const { return currentGR; }
 
+    // Deepest and shallowest gain reduction over the last block (dB)
+    float getBlockGainReductionMin() const { return blockGRMin; }
+    float getBlockGainReductionMax() const { return blockGRMax; }
+    int getTailSamples() const;
+
+    // Receives every sample's GR and input peak while set (nullptr: no history)
+    void setHistory(GainReductionHistory* newHistory) { history = newHistory; }
+
+    // Fully bypassed: the history keeps following this module's input, at 0 dB GR
+    void addBypassedToHistory(const juce::dsp::AudioBlock<float>& block);
+
     enum Style
     {
         VCA = 0,
@@ -75,6 +93,9 @@ private:
 
     double sampleRate = 44100.0;
     float currentGR = 0.0f;
+    float blockGRMin = 0.0f;
+    float blockGRMax = 0.0f;
+    GainReductionHistory* history = nullptr;
 
     // DSP functions
     float processSidechainHPF(float input, float& hpfState, float freq);
@@ -0,0 +1,80 @@
+#include "GainReductionHistory.h"
+#include <limits>
+
+void GainReductionHistory::prepare(double sampleRate)
+{
+    samplesPerPoint = std::max(1, static_cast<int>(std::lround(sampleRate * pointSeconds)));
+    clearPending();
+}
+
+void GainReductionHistory::addIdle(int numSamples)
+{
+    while (numSamples > 0)
+    {
+        const int count = std::min(numSamples, samplesPerPoint - pendingSamples);
+
+        pending.grMin = std::min(pending.grMin, 0.0f);
+        pending.grMax = std::max(pending.grMax, 0.0f);
+        pendingSamples += count;
+        numSamples -= count;
+
+        if (pendingSamples == samplesPerPoint)
+            finishPoint();
+    }
+}
+
+bool GainReductionHistory::pop(GainReductionPoint& point)
+{
+    for (;;)
+    {
+        const auto available = numWritten.load(std::memory_order_acquire);
+
+        // A full ring behind: the oldest slot is the next to be overwritten,
+        // and everything before it is gone
+        if (available - numRead >= static_cast<std::uint64_t>(capacity))
+            numRead = available - static_cast<std::uint64_t>(capacity) + 1;
+
+        if (numRead == available)
+            return false;
+
+        const auto& slot = ring[static_cast<size_t>(numRead % capacity)];
+        point.grMin = slot.grMin.load(std::memory_order_relaxed);
+        point.grMax = slot.grMax.load(std::memory_order_relaxed);
+        point.inputPeak = slot.inputPeak.load(std::memory_order_relaxed);
+
+        // If the writer reached this slot while it was read, the point may be
+        // torn: skip ahead and try again
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (numWritten.load(std::memory_order_relaxed) - numRead < static_cast<std::uint64_t>(capacity))
+        {
+            ++numRead;
+            return true;
+        }
+    }
+}
+
+void GainReductionHistory::finishPoint()
+{
+    const auto index = numWritten.load(std::memory_order_relaxed);
+    auto& slot = ring[static_cast<size_t>(index % capacity)];
+
+    // Orders the previous point's count before this slot's overwrite, so a
+    // reader that sees any of the new values also sees that count
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.grMin.store(pending.grMin, std::memory_order_relaxed);
+    slot.grMax.store(pending.grMax, std::memory_order_relaxed);
+    slot.inputPeak.store(pending.inputPeak, std::memory_order_relaxed);
+    numWritten.store(index + 1, std::memory_order_release);
+
+    clearPending();
+}
+
+void GainReductionHistory::clearPending()
+{
+    pending.grMin = std::numeric_limits<float>::max();
+    pending.grMax = std::numeric_limits<float>::lowest();
+    pending.inputPeak = 0.0f;
+    pendingSamples = 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * One point of the gain-reduction trace: extremes over about a millisecond
+ * GR is in dB (<= 0, grMin = deepest); input peak is linear.
+ */
+struct GainReductionPoint
+{
+    float grMin = 0.0f;
+    float grMax = 0.0f;
+    float inputPeak = 0.0f;
+};
+
+/**
+ * Decimated gain-reduction stream from the audio thread to the editor
+ * The compressor feeds every sample, with its own input peak; each
+ * millisecond becomes one min/max point in a preallocated ring, which the
+ * editor drains to draw a scrolling history. A full ring overwrites its
+ * oldest points, so a reader that fell behind resumes with the newest ones.
+ */
+class GainReductionHistory
+{
+public:
+    static constexpr double pointSeconds = 0.001;
+    static constexpr int capacity = 1024;  // ~1 s of points
+
+    GainReductionHistory() { clearPending(); }
+
+    void prepare(double sampleRate);
+
+    // Whether an editor is reading; the router only feeds the history then
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Audio thread
+    void addSample(float grDB, float inputPeak)
+    {
+        pending.grMin = std::min(pending.grMin, grDB);
+        pending.grMax = std::max(pending.grMax, grDB);
+        pending.inputPeak = std::max(pending.inputPeak, inputPeak);
+
+        if (++pendingSamples == samplesPerPoint)
+            finishPoint();
+    }
+
+    // Samples that never reached the compressor (the chain was asleep)
+    void addIdle(int numSamples);
+
+    // Editor thread. Returns the oldest point not yet overwritten, or false.
+    bool pop(GainReductionPoint& point);
+
+private:
+    // Fields are atomics so a point being overwritten can be read (and then
+    // discarded) without a data race
+    struct Slot
+    {
+        std::atomic<float> grMin{0.0f};
+        std::atomic<float> grMax{0.0f};
+        std::atomic<float> inputPeak{0.0f};
+    };
+
+    std::array<Slot, capacity> ring;
+    std::atomic<std::uint64_t> numWritten{0};  // Points ever finished
+    std::uint64_t numRead = 0;                  // Editor thread only
+    std::atomic<bool> enabled{false};
+
+    GainReductionPoint pending;
+    int pendingSamples = 0;
+    int samplesPerPoint = 44;
+
+    void finishPoint();
+    void clearPending();
+};
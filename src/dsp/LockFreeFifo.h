@@ -0,0 +1,58 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+/**
+ * Single-producer / single-consumer queue for passing data off the audio thread
+ * Storage is allocated once up front; push() and pop() never block or allocate
+ */
+template <typename ItemType>
+class LockFreeFifo
+{
+public:
+    explicit LockFreeFifo(int capacity)
+        : fifo(capacity + 1), items(static_cast<size_t>(capacity + 1))
+    {
+    }
+
+    // Producer side. Returns false (item dropped) if the queue is full.
+    bool push(const ItemType& item)
+    {
+        const auto scope = fifo.write(1);
+
+        if (scope.blockSize1 > 0)
+            items[static_cast<size_t>(scope.startIndex1)] = item;
+        else if (scope.blockSize2 > 0)
+            items[static_cast<size_t>(scope.startIndex2)] = item;
+        else
+            return false;
+
+        return true;
+    }
+
+    // Consumer side. Returns false if the queue is empty.
+    bool pop(ItemType& item)
+    {
+        const auto scope = fifo.read(1);
+
+        if (scope.blockSize1 > 0)
+            item = items[static_cast<size_t>(scope.startIndex1)];
+        else if (scope.blockSize2 > 0)
+            item = items[static_cast<size_t>(scope.startIndex2)];
+        else
+            return false;
+
+        return true;
+    }
+
+    int getNumReady() const { return fifo.getNumReady(); }
+    int getFreeSpace() const { return fifo.getFreeSpace(); }
+
+    // Only call while neither side is running
+    void reset() { fifo.reset(); }
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<ItemType> items;
+};
@@ -0,0 +1,351 @@
+#include "LoudnessMeter.h"
+#include <algorithm>
+#include <cmath>
+
+LoudnessMeter::LoudnessMeter()
+{
+    designTruePeakFilter();
+}
+
+void LoudnessMeter::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    const double sampleRate = spec.sampleRate;
+    numChannels = std::min(maxChannels, static_cast<int>(spec.numChannels));
+    subBlockLength = std::max(1, juce::roundToInt(0.1 * sampleRate));
+
+    // K-weighting stage 1: high shelf (+4 dB above ~1.5 kHz)
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDB = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDB / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = (vh + vb * k / q + k * k) / a0;
+        shelf.b1 = 2.0 * (k * k - vh) / a0;
+        shelf.b2 = (vh - vb * k / q + k * k) / a0;
+        shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+        shelf.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    // K-weighting stage 2: RLB high pass (~38 Hz)
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.0;
+        highPass.b1 = -2.0;
+        highPass.b2 = 1.0;
+        highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+        highPass.a2 = (1.0 - k / q + k * k) / a0;
+    }
+
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    shelfState.fill({});
+    highPassState.fill({});
+
+    subBlockEnergy.fill(0.0);
+    subBlockIndex = 0;
+    subBlocksSeen = 0;
+    subBlockPosition = 0;
+    subBlockSum = 0.0;
+    momentarySum = 0.0;
+    shortTermSum = 0.0;
+
+    integratedHistogram.clear();
+    rangeHistogram.clear();
+
+    for (auto& history : truePeakHistory)
+        history.fill(0.0f);
+
+    truePeakPosition = 0;
+    truePeakMax = 0.0f;
+
+    readings = {};
+}
+
+void LoudnessMeter::designTruePeakFilter()
+{
+    // Windowed-sinc interpolator, cutoff at the original Nyquist frequency
+    constexpr int numTaps = oversampling * tapsPerPhase;
+    constexpr double centre = (numTaps - 1) * 0.5;
+
+    for (int phase = 0; phase < oversampling; ++phase)
+    {
+        double sum = 0.0;
+
+        for (int k = 0; k < tapsPerPhase; ++k)
+        {
+            const int n = phase + k * oversampling;
+            const double x = (n - centre) / oversampling;
+            const double sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x);
+
+            // Blackman window
+            const double w = 0.42 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * (n + 0.5) / numTaps)
+                           + 0.08 * std::cos(2.0 * juce::MathConstants<double>::twoPi * (n + 0.5) / numTaps);
+
+            truePeakTaps[static_cast<size_t>(phase)][static_cast<size_t>(k)] = static_cast<float>(sinc * w);
+            sum += sinc * w;
+        }
+
+        // Unity DC gain per phase
+        for (auto& tap : truePeakTaps[static_cast<size_t>(phase)])
+            tap = static_cast<float>(tap / sum);
+    }
+}
+
+void LoudnessMeter::process(const juce::dsp::AudioBlock<float>& block)
+{
+    const int channels = std::min(numChannels, static_cast<int>(block.getNumChannels()));
+    const int numSamples = static_cast<int>(block.getNumSamples());
+
+    int start = 0;
+
+    while (start < numSamples)
+    {
+        // Never straddle a sub-block boundary
+        const int count = std::min(numSamples - start, subBlockLength - subBlockPosition);
+        int endPosition = truePeakPosition;
+
+        for (int ch = 0; ch < channels; ++ch)
+        {
+            const auto* data = block.getChannelPointer(static_cast<size_t>(ch)) + start;
+
+            auto& s1 = shelfState[static_cast<size_t>(ch)];
+            auto& s2 = highPassState[static_cast<size_t>(ch)];
+            auto& history = truePeakHistory[static_cast<size_t>(ch)];
+
+            double energy = 0.0;
+            float peak = truePeakMax;
+            int position = truePeakPosition;
+
+            for (int i = 0; i < count; ++i)
+            {
+                const double x = data[i];
+
+                // K-weighting
+                const double y1 = shelf.b0 * x + shelf.b1 * s1.x1 + shelf.b2 * s1.x2 - shelf.a1 * s1.y1 - shelf.a2 * s1.y2;
+                s1.x2 = s1.x1;
+                s1.x1 = x;
+                s1.y2 = s1.y1;
+                s1.y1 = y1;
+
+                const double y2 = y1 - 2.0 * s2.x1 + s2.x2 - highPass.a1 * s2.y1 - highPass.a2 * s2.y2;
+                s2.x2 = s2.x1;
+                s2.x1 = y1;
+                s2.y2 = s2.y1;
+                s2.y1 = y2;
+
+                energy += y2 * y2;
+
+                // True peak: the sample itself plus the interpolated points after it
+                position = (position == 0 ? tapsPerPhase : position) - 1;
+                history[static_cast<size_t>(position)] = data[i];
+                history[static_cast<size_t>(position + tapsPerPhase)] = data[i];
+
+                peak = std::max(peak, std::abs(data[i]));
+
+                const float* recent = history.data() + position;
+
+                for (const auto& taps : truePeakTaps)
+                {
+                    float interpolated = 0.0f;
+
+                    for (int k = 0; k < tapsPerPhase; ++k)
+                        interpolated += taps[static_cast<size_t>(k)] * recent[k];
+
+                    peak = std::max(peak, std::abs(interpolated));
+                }
+            }
+
+            subBlockSum += energy;
+            truePeakMax = peak;
+            endPosition = position;
+        }
+
+        truePeakPosition = endPosition;
+        subBlockPosition += count;
+        start += count;
+
+        if (subBlockPosition == subBlockLength)
+            finishSubBlock();
+    }
+
+    readings.truePeak = juce::Decibels::gainToDecibels(truePeakMax, LoudnessReadings::noReading);
+}
+
+void LoudnessMeter::processSilence(int numSamples)
+{
+    // Filters and the interpolator settle to zero on silent input
+    shelfState.fill({});
+    highPassState.fill({});
+
+    for (auto& history : truePeakHistory)
+        history.fill(0.0f);
+
+    while (numSamples > 0)
+    {
+        const int count = std::min(numSamples, subBlockLength - subBlockPosition);
+        subBlockPosition += count;
+        numSamples -= count;
+
+        if (subBlockPosition == subBlockLength)
+            finishSubBlock();
+    }
+}
+
+void LoudnessMeter::finishSubBlock()
+{
+    const double energy = subBlockSum / static_cast<double>(subBlockLength);
+    subBlockSum = 0.0;
+    subBlockPosition = 0;
+
+    // Running window sums: add the new sub-block, drop the one leaving each window
+    const auto leavingMomentary = static_cast<size_t>((subBlockIndex + shortTermSubBlocks - momentarySubBlocks) % shortTermSubBlocks);
+    momentarySum += energy - subBlockEnergy[leavingMomentary];
+    shortTermSum += energy - subBlockEnergy[static_cast<size_t>(subBlockIndex)];
+
+    subBlockEnergy[static_cast<size_t>(subBlockIndex)] = energy;
+    subBlockIndex = (subBlockIndex + 1) % shortTermSubBlocks;
+    subBlocksSeen = std::min(subBlocksSeen + 1, shortTermSubBlocks);
+
+    // Resum once per lap so rounding errors cannot accumulate
+    if (subBlockIndex == 0)
+    {
+        shortTermSum = 0.0;
+        momentarySum = 0.0;
+
+        for (int i = 0; i < shortTermSubBlocks; ++i)
+        {
+            shortTermSum += subBlockEnergy[static_cast<size_t>(i)];
+
+            if (i >= shortTermSubBlocks - momentarySubBlocks)
+                momentarySum += subBlockEnergy[static_cast<size_t>(i)];
+        }
+    }
+
+    // 400 ms gating blocks overlap by 75%, i.e. one per sub-block
+    if (subBlocksSeen >= momentarySubBlocks)
+    {
+        const double momentaryEnergy = std::max(0.0, momentarySum) / momentarySubBlocks;
+        readings.momentary = static_cast<float>(energyToLoudness(momentaryEnergy));
+        integratedHistogram.add(momentaryEnergy);
+    }
+
+    // Loudness range samples the short-term loudness at 10 Hz
+    if (subBlocksSeen >= shortTermSubBlocks)
+    {
+        const double shortTermEnergy = std::max(0.0, shortTermSum) / shortTermSubBlocks;
+        readings.shortTerm = static_cast<float>(energyToLoudness(shortTermEnergy));
+        rangeHistogram.add(shortTermEnergy);
+    }
+
+    updateGatedReadings();
+}
+
+void LoudnessMeter::updateGatedReadings()
+{
+    // Integrated: relative gate 10 LU below the absolute-gated level
+    readings.integrated = static_cast<float>(energyToLoudness(integratedHistogram.getGatedMeanEnergy(-10.0)));
+
+    // Loudness range: 10th to 95th percentile above a -20 LU relative gate
+    const int gateBin = rangeHistogram.getRelativeGateBin(-20.0);
+    juce::int64 count = 0;
+
+    for (int i = gateBin; i < numHistogramBins; ++i)
+        count += rangeHistogram.counts[static_cast<size_t>(i)];
+
+    if (count == 0)
+    {
+        readings.range = 0.0f;
+        return;
+    }
+
+    const double lowTarget = 0.10 * static_cast<double>(count);
+    const double highTarget = 0.95 * static_cast<double>(count);
+    int lowBin = -1;
+    int highBin = gateBin;
+    juce::int64 cumulative = 0;
+
+    for (int i = gateBin; i < numHistogramBins; ++i)
+    {
+        cumulative += rangeHistogram.counts[static_cast<size_t>(i)];
+
+        if (lowBin < 0 && static_cast<double>(cumulative) >= lowTarget)
+            lowBin = i;
+
+        if (static_cast<double>(cumulative) >= highTarget)
+        {
+            highBin = i;
+            break;
+        }
+    }
+
+    readings.range = static_cast<float>((highBin - std::max(lowBin, gateBin)) * histogramStep);
+}
+
+double LoudnessMeter::energyToLoudness(double energy)
+{
+    if (energy <= 0.0)
+        return LoudnessReadings::noReading;
+
+    return std::max(static_cast<double>(LoudnessReadings::noReading), -0.691 + 10.0 * std::log10(energy));
+}
+
+//==============================================================================
+void LoudnessMeter::Histogram::clear()
+{
+    counts.fill(0);
+    energies.fill(0.0);
+    totalCount = 0;
+    totalEnergy = 0.0;
+}
+
+void LoudnessMeter::Histogram::add(double energy)
+{
+    const double loudness = energyToLoudness(energy);
+
+    // Absolute gate
+    if (loudness <= histogramMin)
+        return;
+
+    const int bin = juce::jlimit(0, numHistogramBins - 1, static_cast<int>((loudness - histogramMin) / histogramStep));
+
+    ++counts[static_cast<size_t>(bin)];
+    energies[static_cast<size_t>(bin)] += energy;
+    ++totalCount;
+    totalEnergy += energy;
+}
+
+int LoudnessMeter::Histogram::getRelativeGateBin(double relativeGateLU) const
+{
+    if (totalCount == 0)
+        return numHistogramBins;
+
+    const double gate = energyToLoudness(totalEnergy / static_cast<double>(totalCount)) + relativeGateLU;
+    return juce::jlimit(0, numHistogramBins - 1, static_cast<int>(std::floor((gate - histogramMin) / histogramStep)));
+}
+
+double LoudnessMeter::Histogram::getGatedMeanEnergy(double relativeGateLU) const
+{
+    juce::int64 count = 0;
+    double energy = 0.0;
+
+    for (int i = getRelativeGateBin(relativeGateLU); i < numHistogramBins; ++i)
+    {
+        count += counts[static_cast<size_t>(i)];
+        energy += energies[static_cast<size_t>(i)];
+    }
+
+    return count > 0 ? energy / static_cast<double>(count) : 0.0;
+}
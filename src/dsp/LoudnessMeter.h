@@ -0,0 +1,99 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "Metering.h"
+#include <array>
+
+/**
+ * ITU-R BS.1770-4 / EBU R128 loudness meter
+ * K-weighted energy is summed into 100 ms sub-blocks; momentary (400 ms) and
+ * short-term (3 s) windows are running sums over those. Integrated loudness
+ * and loudness range are gated from fixed-resolution histograms, so memory
+ * stays constant however long the measurement runs. True peak uses 4x
+ * polyphase oversampling.
+ */
+class LoudnessMeter
+{
+public:
+    LoudnessMeter();
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    // Clears the integrated measurement, loudness range and peak hold
+    void reset();
+
+    void process(const juce::dsp::AudioBlock<float>& block);
+
+    // Advances the windows over digital silence without filtering it
+    void processSilence(int numSamples);
+
+    const LoudnessReadings& getReadings() const { return readings; }
+
+private:
+    static constexpr int maxChannels = 2;
+    static constexpr int momentarySubBlocks = 4;
+    static constexpr int shortTermSubBlocks = 30;
+
+    // K-weighting: high shelf followed by high pass (direct form I)
+    struct Biquad
+    {
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+    };
+
+    struct FilterState
+    {
+        double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+    };
+
+    Biquad shelf, highPass;
+    std::array<FilterState, maxChannels> shelfState, highPassState;
+
+    // Sub-block energy ring covering the short-term window
+    std::array<double, shortTermSubBlocks> subBlockEnergy{};
+    int subBlockIndex = 0;
+    int subBlocksSeen = 0;
+    int subBlockLength = 4800;
+    int subBlockPosition = 0;
+    double subBlockSum = 0.0;
+    double momentarySum = 0.0;
+    double shortTermSum = 0.0;
+
+    // Loudness histogram, 0.1 LU bins from -70 to +10 LUFS
+    static constexpr double histogramMin = -70.0;
+    static constexpr double histogramStep = 0.1;
+    static constexpr int numHistogramBins = 800;
+
+    struct Histogram
+    {
+        std::array<juce::int64, numHistogramBins> counts{};
+        std::array<double, numHistogramBins> energies{};
+        juce::int64 totalCount = 0;
+        double totalEnergy = 0.0;
+
+        void clear();
+        void add(double energy);
+        int getRelativeGateBin(double relativeGateLU) const;
+        double getGatedMeanEnergy(double relativeGateLU) const;
+    };
+
+    Histogram integratedHistogram;
+    Histogram rangeHistogram;
+
+    // True peak: 4 phases x 12 taps, history stored twice to avoid wrapping
+    static constexpr int oversampling = 4;
+    static constexpr int tapsPerPhase = 12;
+
+    std::array<std::array<float, tapsPerPhase>, oversampling> truePeakTaps{};
+    std::array<std::array<float, tapsPerPhase * 2>, maxChannels> truePeakHistory{};
+    int truePeakPosition = 0;
+    float truePeakMax = 0.0f;
+
+    LoudnessReadings readings;
+    int numChannels = 2;
+
+    void designTruePeakFilter();
+    void finishSubBlock();
+    void updateGatedReadings();
+
+    static double energyToLoudness(double energy);
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * BS.1770 / EBU R128 loudness readings (LUFS, LU, dBTP)
+ * Values sit at noReading until enough audio has been measured.
+ */
+struct LoudnessReadings
+{
+    static constexpr float noReading = -100.0f;
+
+    float momentary = noReading;   // 400 ms window
+    float shortTerm = noReading;   // 3 s window
+    float integrated = noReading;  // gated, since last reset
+    float range = 0.0f;            // loudness range (LRA), LU
+    float truePeak = noReading;    // 4x oversampled, since last reset
+};
+
+/**
+ * Meter readings for one processed block, published from the audio thread
+ * Peak and RMS are linear; gain reduction is in dB (<= 0).
+ * Ballistics (peak hold, decay, averaging) are applied on the UI side.
+ */
+struct MeterFrame
+{
+    float inputPeak[2] = {0.0f, 0.0f};
+    float inputRMS[2] = {0.0f, 0.0f};
+    float outputPeak[2] = {0.0f, 0.0f};
+    float outputRMS[2] = {0.0f, 0.0f};
+
+    // Gain reduction extremes over the block (grMin = deepest reduction)
+    float grMin = 0.0f;
+    float grMax = 0.0f;
+
+    float durationSeconds = 0.0f;
+
+    LoudnessReadings inputLoudness;
+    LoudnessReadings outputLoudness;
+
+    // Folds a later frame into this one: peaks and gain reduction hold their
+    // extremes, RMS averages energy over the combined duration, loudness
+    // takes the newest readings
+    void merge(const MeterFrame& later)
+    {
+        const float total = durationSeconds + later.durationSeconds;
+        const float weight = total > 0.0f ? later.durationSeconds / total : 1.0f;
+
+        auto mergeRMS = [weight](float a, float b) {
+            return std::sqrt(a * a + (b * b - a * a) * weight);
+        };
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            inputPeak[ch] = std::max(inputPeak[ch], later.inputPeak[ch]);
+            outputPeak[ch] = std::max(outputPeak[ch], later.outputPeak[ch]);
+            inputRMS[ch] = mergeRMS(inputRMS[ch], later.inputRMS[ch]);
+            outputRMS[ch] = mergeRMS(outputRMS[ch], later.outputRMS[ch]);
+        }
+
+        grMin = std::min(grMin, later.grMin);
+        grMax = std::max(grMax, later.grMax);
+        durationSeconds = total;
+
+        inputLoudness = later.inputLoudness;
+        outputLoudness = later.outputLoudness;
+    }
+};
@@ -0,0 +1,183 @@
+#include "ModuleBypass.h"
+#include <algorithm>
+
+ModuleBypass::ModuleBypass()
+{
+}
+
+void ModuleBypass::prepare(const juce::dsp::ProcessSpec& spec, int maxLatencySamples)
+{
+    sampleRate = spec.sampleRate;
+
+    // Pre-size everything so toggling never allocates
+    delayLine.setMaximumDelayInSamples(std::max(1, maxLatencySamples));
+    delayLine.prepare(spec);
+    dryBuffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+
+    setFadeTime(fadeTimeMs);
+    reset();
+}
+
+void ModuleBypass::reset()
+{
+    delayLine.reset();
+    dryBuffer.clear();
+
+    // Next block snaps to the requested state without fading
+    initialised = false;
+    primeRemaining = 0;
+}
+
+void ModuleBypass::copyStateFrom(const ModuleBypass& other)
+{
+    // Both slots were prepared with the same sizes, so this does not allocate
+    delayLine = other.delayLine;
+
+    state = other.state;
+    initialised = other.initialised;
+    targetActive = other.targetActive;
+    dropLatency = other.dropLatency;
+    undelayedDry = other.undelayedDry;
+    wetGain = other.wetGain;
+    primeRemaining = other.primeRemaining;
+    latencySamples = other.latencySamples;
+}
+
+void ModuleBypass::setFadeTime(float timeMs)
+{
+    fadeTimeMs = timeMs;
+    fadeStep = 1.0f / std::max(1.0f, fadeTimeMs * 0.001f * static_cast<float>(sampleRate));
+}
+
+bool ModuleBypass::setBypassed(bool shouldBypass, int moduleLatencySamples)
+{
+    if (moduleLatencySamples != latencySamples)
+    {
+        latencySamples = moduleLatencySamples;
+        delayLine.setDelay(static_cast<float>(latencySamples));
+    }
+
+    const bool shouldBeActive = !shouldBypass;
+
+    if (!initialised)
+    {
+        initialised = true;
+        targetActive = shouldBeActive;
+        wetGain = shouldBeActive ? 1.0f : 0.0f;
+        state = shouldBeActive ? State::Active : State::Bypassed;
+        primeRemaining = 0;
+        return false;
+    }
+
+    if (shouldBeActive == targetActive)
+        return false;
+
+    targetActive = shouldBeActive;
+
+    if (state == State::Active)
+    {
+        // Fill the dry delay line before fading out; an undelayed dry path
+        // needs no priming
+        undelayedDry = dropLatency;
+        delayLine.reset();
+        primeRemaining = undelayedDry ? 0 : latencySamples;
+        state = State::Fading;
+        return false;
+    }
+
+    if (state == State::Bypassed)
+    {
+        // The module restarts clean and refills its FIFOs before fading in.
+        // With the latency dropped, the output stays undelayed until then.
+        undelayedDry = dropLatency;
+
+        if (undelayedDry)
+            delayLine.reset();
+
+        primeRemaining = latencySamples;
+        state = State::Fading;
+        return true;
+    }
+
+    // Reversed mid-fade: carry on from the current gain
+    return false;
+}
+
+void ModuleBypass::captureDry(const juce::dsp::AudioBlock<float>& block)
+{
+    const int numChannels = static_cast<int>(block.getNumChannels());
+    const int numSamples = static_cast<int>(block.getNumSamples());
+
+    // Dropped latency: the crossfade itself moves between the undelayed input
+    // and the delayed module output, in either direction
+    if (latencySamples == 0 || undelayedDry)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            dryBuffer.copyFrom(ch, 0, block.getChannelPointer(ch), numSamples);
+        return;
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* input = block.getChannelPointer(ch);
+        auto* dry = dryBuffer.getWritePointer(ch);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            delayLine.pushSample(ch, input[i]);
+            dry[i] = delayLine.popSample(ch);
+        }
+    }
+}
+
+void ModuleBypass::mixWet(juce::dsp::AudioBlock<float>& block)
+{
+    const int numChannels = static_cast<int>(block.getNumChannels());
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const float target = targetActive ? 1.0f : 0.0f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Hold the gain while the module (or the dry delay) is priming
+        if (primeRemaining > 0)
+            --primeRemaining;
+        else if (targetActive)
+            wetGain = std::min(1.0f, wetGain + fadeStep);
+        else
+            wetGain = std::max(0.0f, wetGain - fadeStep);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float wet = block.getSample(ch, i);
+            const float dry = dryBuffer.getSample(ch, i);
+            block.setSample(ch, i, dry + (wet - dry) * wetGain);
+        }
+    }
+
+    if (wetGain == target)
+    {
+        state = targetActive ? State::Active : State::Bypassed;
+        primeRemaining = 0;
+    }
+}
+
+void ModuleBypass::processBypassed(juce::dsp::AudioBlock<float>& block)
+{
+    if (dropLatency || latencySamples == 0)
+        return;
+
+    // Keep the module's latency so the host's delay compensation stays valid
+    const int numChannels = static_cast<int>(block.getNumChannels());
+    const int numSamples = static_cast<int>(block.getNumSamples());
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* data = block.getChannelPointer(ch);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            delayLine.pushSample(ch, data[i]);
+            data[i] = delayLine.popSample(ch);
+        }
+    }
+}
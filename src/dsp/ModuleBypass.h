@@ -0,0 +1,67 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/**
+ * Click-free, latency-preserving bypass for one module slot
+ * Toggling crossfades between the module output and a dry path delayed by
+ * the module's latency. Before each fade the module runs for one latency
+ * period so both sides of the crossfade are time-aligned. Fully bypassed,
+ * only the delay line runs (or nothing, if latency may drop to zero).
+ * When latency drops, fades run against the undelayed input instead, so
+ * the jump in timing happens inside the crossfade rather than after it.
+ */
+class ModuleBypass
+{
+public:
+    ModuleBypass();
+
+    void prepare(const juce::dsp::ProcessSpec& spec, int maxLatencySamples);
+    void reset();
+
+    // Takes over another slot's fade position and delay line contents
+    void copyStateFrom(const ModuleBypass& other);
+
+    void setFadeTime(float timeMs);
+    void setDropLatencyWhenBypassed(bool shouldDrop) { dropLatency = shouldDrop; }
+
+    // Returns true if the module must be reset before it runs again
+    bool setBypassed(bool shouldBypass, int moduleLatencySamples);
+
+    bool isFullyActive() const { return state == State::Active; }
+    bool isFullyBypassed() const { return state == State::Bypassed; }
+    bool isLatencyDropped() const { return dropLatency && state == State::Bypassed; }
+
+    // While fading: call before and after running the module
+    void captureDry(const juce::dsp::AudioBlock<float>& block);
+    void mixWet(juce::dsp::AudioBlock<float>& block);
+
+    // While fully bypassed: the module does not run at all
+    void processBypassed(juce::dsp::AudioBlock<float>& block);
+
+private:
+    enum class State
+    {
+        Active,
+        Bypassed,
+        Fading
+    };
+
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::None> delayLine;
+    juce::AudioBuffer<float> dryBuffer;
+
+    State state = State::Active;
+    bool initialised = false;
+    bool targetActive = true;
+    bool dropLatency = false;
+    bool undelayedDry = false;  // Latched from dropLatency when a fade starts
+
+    float wetGain = 1.0f;
+    float fadeStep = 1.0f;
+    float fadeTimeMs = 10.0f;
+    int primeRemaining = 0;
+    int latencySamples = 0;
+
+    double sampleRate = 44100.0;
+};
@@ -0,0 +1,78 @@
+#include "ProcessingProfiler.h"
+#include <algorithm>
+#include <cmath>
+
+ProcessingProfiler::ProcessingProfiler()
+{
+    microsecondsPerTick = 1.0e6 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+}
+
+void ProcessingProfiler::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    averageMicroseconds.fill(0.0f);
+    maxMicroseconds.fill(0.0f);
+    maxLoad.fill(0.0f);
+    peakResetRequested.store(true, std::memory_order_relaxed);
+}
+
+ProcessingProfiler::Stats ProcessingProfiler::getStats(Slot slot) const
+{
+    const auto& p = published[static_cast<size_t>(slot)];
+
+    Stats stats;
+    stats.averageMicroseconds = p.averageMicroseconds.load(std::memory_order_relaxed);
+    stats.maxMicroseconds = p.maxMicroseconds.load(std::memory_order_relaxed);
+    stats.averageLoad = p.averageLoad.load(std::memory_order_relaxed);
+    stats.maxLoad = p.maxLoad.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool ProcessingProfiler::beginBlock()
+{
+    measuring = enabled.load(std::memory_order_relaxed);
+
+    if (measuring)
+    {
+        blockTicks.fill(0);
+        blockStart = now();
+    }
+
+    return measuring;
+}
+
+void ProcessingProfiler::endBlock(int numSamples)
+{
+    if (!measuring || numSamples <= 0)
+        return;
+
+    blockTicks[Total] = now() - blockStart;
+
+    if (peakResetRequested.exchange(false, std::memory_order_relaxed))
+    {
+        maxMicroseconds.fill(0.0f);
+        maxLoad.fill(0.0f);
+    }
+
+    // Exponential moving average with a time constant in seconds, not blocks
+    const double blockSeconds = numSamples / sampleRate;
+    const auto coeff = static_cast<float>(1.0 - std::exp(-blockSeconds / averagingTimeSeconds));
+    const auto deadlineMicroseconds = static_cast<float>(blockSeconds * 1.0e6);
+
+    for (size_t slot = 0; slot < numSlots; ++slot)
+    {
+        const auto micros = static_cast<float>(static_cast<double>(blockTicks[slot]) * microsecondsPerTick);
+        const float load = micros / deadlineMicroseconds;
+
+        averageMicroseconds[slot] += (micros - averageMicroseconds[slot]) * coeff;
+        maxMicroseconds[slot] = std::max(maxMicroseconds[slot], micros);
+        maxLoad[slot] = std::max(maxLoad[slot], load);
+
+        auto& p = published[slot];
+        p.averageMicroseconds.store(averageMicroseconds[slot], std::memory_order_relaxed);
+        p.maxMicroseconds.store(maxMicroseconds[slot], std::memory_order_relaxed);
+        p.averageLoad.store(averageMicroseconds[slot] / deadlineMicroseconds, std::memory_order_relaxed);
+        p.maxLoad.store(maxLoad[slot], std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+
+/**
+ * Per-stage CPU time counters for the router
+ * While enabled, each stage is timed with the high-resolution tick counter
+ * and the audio thread publishes moving averages and peaks through atomics.
+ * While disabled the cost is one relaxed atomic load per block.
+ */
+class ProcessingProfiler
+{
+public:
+    enum Slot
+    {
+        Soothe = 0,
+        Compressor,
+        Color,
+        Total,
+        numSlots
+    };
+
+    struct Stats
+    {
+        float averageMicroseconds = 0.0f;  // Per block
+        float maxMicroseconds = 0.0f;
+        float averageLoad = 0.0f;          // Fraction of the block's real-time deadline
+        float maxLoad = 0.0f;
+    };
+
+    ProcessingProfiler();
+
+    void prepare(double sampleRate);
+
+    // Any thread
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+    void resetPeaks() { peakResetRequested.store(true, std::memory_order_relaxed); }
+    Stats getStats(Slot slot) const;
+
+    // Audio thread: beginBlock() decides whether this block is measured
+    bool beginBlock();
+    void addTime(Slot slot, juce::int64 ticks) { blockTicks[static_cast<size_t>(slot)] += ticks; }
+    void endBlock(int numSamples);
+    bool isMeasuring() const { return measuring; }
+
+    static juce::int64 now() { return juce::Time::getHighResolutionTicks(); }
+
+private:
+    struct PublishedStats
+    {
+        std::atomic<float> averageMicroseconds{0.0f};
+        std::atomic<float> maxMicroseconds{0.0f};
+        std::atomic<float> averageLoad{0.0f};
+        std::atomic<float> maxLoad{0.0f};
+    };
+
+    std::atomic<bool> enabled{false};
+    std::atomic<bool> peakResetRequested{false};
+    std::array<PublishedStats, numSlots> published;
+
+    // Audio thread only
+    std::array<juce::int64, numSlots> blockTicks{};
+    std::array<float, numSlots> averageMicroseconds{};
+    std::array<float, numSlots> maxMicroseconds{};
+    std::array<float, numSlots> maxLoad{};
+    juce::int64 blockStart = 0;
+    bool measuring = false;
+    double sampleRate = 44100.0;
+    double microsecondsPerTick = 1.0;
+
+    static constexpr double averagingTimeSeconds = 0.5;
+};
@@ -1,81 +1,481 @@
 #include "RouterModule.h"
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <cmath>
 
 RouterModule::RouterModule()
 {
+    // Only the active chain publishes; the display has a single writer
+    activeChain().soothe.setDisplay(&sootheDisplay);
+    shadowChain().soothe.setDisplay(nullptr);
 }
 
-void RouterModule::prepare(const juce::dsp::ProcessSpec& spec)
+void RouterModule::Chain::prepare(const juce::dsp::ProcessSpec& spec)
 {
-    sampleRate = spec.sampleRate;
-
     compressor.prepare(spec);
     color.prepare(spec);
     soothe.prepare(spec);
 
+    compBypass.prepare(spec, 0);
+    colorBypass.prepare(spec, 0);
+    sootheBypass.prepare(spec, soothe.getMaxLatencySamples());
+}
+
+void RouterModule::Chain::reset()
+{
+    compressor.reset();
+    color.reset();
+    soothe.reset();
+
+    compBypass.reset();
+    colorBypass.reset();
+    sootheBypass.reset();
+}
+
+bool RouterModule::Chain::copyStateFrom(const Chain& other)
+{
+    // Soothe first: it refuses while pooled frames are in flight
+    if (!soothe.copyStateFrom(other.soothe))
+        return false;
+
+    compressor.copyStateFrom(other.compressor);
+    color.copyStateFrom(other.color);
+
+    compBypass.copyStateFrom(other.compBypass);
+    colorBypass.copyStateFrom(other.colorBypass);
+    sootheBypass.copyStateFrom(other.sootheBypass);
+    return true;
+}
+
+void RouterModule::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+
+    for (auto& chain : chains)
+        chain.prepare(spec);
+
+    silenceDetector.prepare(spec);
+    profiler.prepare(spec.sampleRate);
+    grHistory.prepare(spec.sampleRate);
+    inputLoudness.prepare(spec);
+    outputLoudness.prepare(spec);
+
     inputGain.prepare(spec);
-    outputGain.prepare(spec);
+    outputGain.reset(spec.sampleRate, 0.02);
+    outputGain.setCurrentAndTargetValue(1.0f);
+
+    transitionBuffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
 
     reset();
 }
 
 void RouterModule::reset()
 {
-    compressor.reset();
-    color.reset();
-    soothe.reset();
+    resetModules();
+    silenceDetector.reset();
+    resetLoudness();
+    publishLatencyAndTail();
+}
+
+void RouterModule::resetLoudness()
+{
+    inputLoudness.reset();
+    outputLoudness.reset();
+}
+
+void RouterModule::resetModules()
+{
+    for (auto& chain : chains)
+        chain.reset();
 
     inputGain.reset();
-    outputGain.reset();
+    outputGain.setCurrentAndTargetValue(outputGain.getTargetValue());
+
+    // Next block picks up the routing parameter directly
+    currentRoute = -1;
+    targetRoute = -1;
+    transitionRemaining = 0;
 }
 
 void RouterModule::process(juce::dsp::ProcessContextReplacing<float>& context, Parameters& params)
 {
     auto block = context.getOutputBlock();
+    profiler.beginBlock();
+
+    // Idle instances skip the whole chain once every tail has decayed
+    silenceDetector.setTailSamples(computeTailSamples());
+
+    const bool chainRuns = silenceDetector.process(block);
+
+    // Input meter comes from the detector's pass over the block
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        meterFrame.inputPeak[ch] = silenceDetector.getPeak(ch);
+        meterFrame.inputRMS[ch] = silenceDetector.getRMS(ch);
+    }
+
+    meterFrame.durationSeconds = static_cast<float>(static_cast<double>(block.getNumSamples()) / sampleRate);
+
+    if (!chainRuns)
+    {
+        // Start from a clean state when signal returns
+        if (silenceDetector.hasJustFallenAsleep())
+            resetModules();
+
+        block.clear();
+
+        // Loudness windows keep moving so momentary readings fall away
+        inputLoudness.processSilence(static_cast<int>(block.getNumSamples()));
+        outputLoudness.processSilence(static_cast<int>(block.getNumSamples()));
+        meterFrame.inputLoudness = inputLoudness.getReadings();
+        meterFrame.outputLoudness = outputLoudness.getReadings();
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            meterFrame.outputPeak[ch] = 0.0f;
+            meterFrame.outputRMS[ch] = 0.0f;
+        }
+
+        meterFrame.grMin = 0.0f;
+        meterFrame.grMax = 0.0f;
+
+        // Nothing reaches the compressor, but the history keeps moving
+        if (grHistory.isEnabled())
+            grHistory.addIdle(static_cast<int>(block.getNumSamples()));
+
+        numChainsProcessed.store(0, std::memory_order_relaxed);
+        publishLatencyAndTail();
+        profiler.endBlock(static_cast<int>(block.getNumSamples()));
+        return;
+    }
+
+    inputLoudness.process(block);
+    meterFrame.inputLoudness = inputLoudness.getReadings();
 
     // Input trim
     const float inputTrimDB = params.getValue(ParamIDs::inputTrim);
     inputGain.setGainDecibels(inputTrimDB);
     inputGain.process(context);
 
+    updateBypassStates(activeChain(), params);
+
+    // Only the active chain feeds the GR history, and only while it is read
+    activeChain().compressor.setHistory(grHistory.isEnabled() ? &grHistory : nullptr);
+    shadowChain().compressor.setHistory(nullptr);
+
     // Route selection
     const int routing = params.getIntValue(ParamIDs::routing);
 
-    if (routing == 0)
+    if (currentRoute < 0)
+        currentRoute = routing;  // First block after a reset: nothing to fade from
+    else if (routing != currentRoute && !isRouteTransitioning())
+        beginRouteTransition(routing);
+
+    if (isRouteTransitioning())
     {
-        processRouteA(block, params);
+        numChainsProcessed.store(2, std::memory_order_relaxed);
+        processRouteTransition(block, params);
     }
     else
     {
-        processRouteB(block, params);
+        numChainsProcessed.store(1, std::memory_order_relaxed);
+        processRoute(activeChain(), currentRoute, block, params);
     }
 
-    // Output trim
+    updateGainReductionMeter();
+
+    // Output trim (also measures the output meter)
     const float outputTrimDB = params.getValue(ParamIDs::outputTrim);
-    outputGain.setGainDecibels(outputTrimDB);
-    outputGain.process(context);
+    processOutputTrim(block, outputTrimDB);
+
+    outputLoudness.process(block);
+    meterFrame.outputLoudness = outputLoudness.getReadings();
+
+    publishLatencyAndTail();
+    profiler.endBlock(static_cast<int>(block.getNumSamples()));
 
     // Global mix (if needed)
     // For now, individual modules handle their own mix
 }
 
-void RouterModule::processRouteA(juce::dsp::AudioBlock<float>& block, Parameters& params)
+void RouterModule::updateBypassStates(Chain& chain, const Parameters& params)
+{
+    chain.sootheBypass.setDropLatencyWhenBypassed(params.getIntValue(ParamIDs::bypassLatency) == 1);
+
+    // A module coming out of bypass restarts from a clean state
+    if (chain.compBypass.setBypassed(params.getBoolValue(ParamIDs::compBypass), 0))
+        chain.compressor.reset();
+
+    if (chain.colorBypass.setBypassed(params.getBoolValue(ParamIDs::colorBypass), 0))
+        chain.color.reset();
+
+    // Soothe's latency follows its quality even while it does not run
+    chain.soothe.updateSettings(params);
+
+    if (chain.sootheBypass.setBypassed(params.getBoolValue(ParamIDs::sootheBypass), chain.soothe.getLatencySamples()))
+        chain.soothe.reset();
+}
+
+void RouterModule::updateGainReductionMeter()
+{
+    const auto& chain = activeChain();
+
+    if (chain.compBypass.isFullyBypassed())
+    {
+        meterFrame.grMin = 0.0f;
+        meterFrame.grMax = 0.0f;
+    }
+    else
+    {
+        meterFrame.grMin = chain.compressor.getBlockGainReductionMin();
+        meterFrame.grMax = chain.compressor.getBlockGainReductionMax();
+    }
+}
+
+void RouterModule::processOutputTrim(juce::dsp::AudioBlock<float>& block, float gainDB)
+{
+    outputGain.setTargetValue(juce::Decibels::decibelsToGain(gainDB));
+
+    const int numChannels = std::min(2, static_cast<int>(block.getNumChannels()));
+    const int numSamples = static_cast<int>(block.getNumSamples());
+
+    // Trim and output metering share one pass
+    float peak[2] = {0.0f, 0.0f};
+    float sumSquares[2] = {0.0f, 0.0f};
+
+    if (!outputGain.isSmoothing())
+    {
+        const float gain = outputGain.getTargetValue();
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = block.getChannelPointer(static_cast<size_t>(ch));
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float y = data[i] * gain;
+                data[i] = y;
+                peak[ch] = std::max(peak[ch], std::abs(y));
+                sumSquares[ch] += y * y;
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float gain = outputGain.getNextValue();
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float y = block.getSample(ch, i) * gain;
+                block.setSample(ch, i, y);
+                peak[ch] = std::max(peak[ch], std::abs(y));
+                sumSquares[ch] += y * y;
+            }
+        }
+    }
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        // Mono mirrors channel 0 onto both meters
+        const int source = std::min(ch, numChannels - 1);
+        meterFrame.outputPeak[ch] = peak[source];
+        meterFrame.outputRMS[ch] = numSamples > 0 ? std::sqrt(sumSquares[source] / static_cast<float>(numSamples)) : 0.0f;
+    }
+}
+
+void RouterModule::beginRouteTransition(int newRoute)
+{
+    // The incoming ordering continues from the outgoing chain's state. While
+    // Soothe frames are in flight on the shared pool it cannot be copied
+    // yet; the route change starts on a later block instead of waiting.
+    if (!shadowChain().copyStateFrom(activeChain()))
+        return;
+
+    // Long enough for the incoming Soothe FIFO to deliver reordered audio
+    transitionLength = activeChain().soothe.getLatencySamples() + static_cast<int>(0.02 * sampleRate);
+    transitionRemaining = transitionLength;
+    targetRoute = newRoute;
+}
+
+void RouterModule::processRouteTransition(juce::dsp::AudioBlock<float>& block, Parameters& params)
+{
+    const auto numChannels = block.getNumChannels();
+    const auto numSamples = block.getNumSamples();
+
+    // The incoming route runs on a copy of the input
+    auto incomingBlock = juce::dsp::AudioBlock<float>(transitionBuffer)
+                             .getSubsetChannelBlock(0, numChannels)
+                             .getSubBlock(0, numSamples);
+    incomingBlock.copyFrom(block);
+
+    Chain& outgoing = activeChain();
+    Chain& incoming = shadowChain();
+
+    updateBypassStates(incoming, params);
+    processRoute(outgoing, currentRoute, block, params);
+    processRoute(incoming, targetRoute, incomingBlock, params);
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        if (transitionRemaining > 0)
+            --transitionRemaining;
+
+        const float gain = 1.0f - static_cast<float>(transitionRemaining) / static_cast<float>(transitionLength);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            const float oldSample = block.getSample(static_cast<int>(ch), static_cast<int>(i));
+            const float newSample = incomingBlock.getSample(static_cast<int>(ch), static_cast<int>(i));
+            block.setSample(static_cast<int>(ch), static_cast<int>(i), oldSample + (newSample - oldSample) * gain);
+        }
+    }
+
+    // Done: the incoming chain takes over, the old one goes idle
+    if (transitionRemaining == 0)
+    {
+        activeChainIndex = 1 - activeChainIndex;
+        currentRoute = targetRoute;
+        targetRoute = -1;
+
+        // The display follows, as the GR history does from the next block
+        shadowChain().soothe.setDisplay(nullptr);
+        activeChain().soothe.setDisplay(&sootheDisplay);
+    }
+}
+
+template <typename Module>
+void RouterModule::processModule(Module& module, ModuleBypass& bypass,
+                                 juce::dsp::AudioBlock<float>& block, Parameters& params)
+{
+    if (bypass.isFullyActive())
+    {
+        module.processActive(block, params);
+    }
+    else if (bypass.isFullyBypassed())
+    {
+        // Nothing inside the module runs
+        bypass.processBypassed(block);
+    }
+    else
+    {
+        bypass.captureDry(block);
+        module.processActive(block, params);
+        bypass.mixWet(block);
+    }
+}
+
+template <RouterModule::Stage stage>
+void RouterModule::processStage(Chain& chain, juce::dsp::AudioBlock<float>& block, Parameters& params)
+{
+    const bool measuring = profiler.isMeasuring();
+    const auto startTicks = measuring ? ProcessingProfiler::now() : 0;
+
+    MCC_TRACE_SCOPE(getStageName(stage));
+
+    if constexpr (stage == Stage::Soothe)
+        processModule(chain.soothe, chain.sootheBypass, block, params);
+    else if constexpr (stage == Stage::Compressor)
+    {
+        // Only the active chain's compressor has the history to feed
+        if (chain.compBypass.isFullyBypassed())
+            chain.compressor.addBypassedToHistory(block);
+
+        processModule(chain.compressor, chain.compBypass, block, params);
+    }
+    else if constexpr (stage == Stage::Color)
+        processModule(chain.color, chain.colorBypass, block, params);
+
+    // Both chains add up during a route crossfade
+    if (measuring)
+        profiler.addTime(getProfilerSlot(stage), ProcessingProfiler::now() - startTicks);
+}
+
+ProcessingProfiler::Slot RouterModule::getProfilerSlot(Stage stage)
 {
-    // Route A: Soothe → Compressor → Color
-    soothe.process(block, params);
-    compressor.process(block, params);
-    color.process(block, params);
+    switch (stage)
+    {
+        case Stage::Soothe:     return ProcessingProfiler::Soothe;
+        case Stage::Compressor: return ProcessingProfiler::Compressor;
+        case Stage::Color:      return ProcessingProfiler::Color;
+    }
+
+    return ProcessingProfiler::Total;
+}
+
+const char* RouterModule::getStageName(Stage stage)
+{
+    switch (stage)
+    {
+        case Stage::Soothe:     return "Soothe";
+        case Stage::Compressor: return "Compressor";
+        case Stage::Color:      return "Color";
+    }
+
+    return "";
 }
 
-void RouterModule::processRouteB(juce::dsp::AudioBlock<float>& block, Parameters& params)
+template <RouterModule::Stage... stages>
+void RouterModule::processChain(Chain& chain, juce::dsp::AudioBlock<float>& block, Parameters& params)
 {
-    // Route B: Compressor → Color → Soothe
-    compressor.process(block, params);
-    color.process(block, params);
-    soothe.process(block, params);
+    (processStage<stages>(chain, block, params), ...);
+}
+
+// Indexed by the routing parameter; order matches its choice list
+const std::array<RouterModule::ChainFunction, RouterModule::numRoutes> RouterModule::routeTable = {
+    &RouterModule::processChain<Stage::Soothe, Stage::Compressor, Stage::Color>,
+    &RouterModule::processChain<Stage::Compressor, Stage::Color, Stage::Soothe>,
+    &RouterModule::processChain<Stage::Soothe, Stage::Color, Stage::Compressor>,
+    &RouterModule::processChain<Stage::Compressor, Stage::Soothe, Stage::Color>,
+    &RouterModule::processChain<Stage::Color, Stage::Compressor, Stage::Soothe>,
+    &RouterModule::processChain<Stage::Color, Stage::Soothe, Stage::Compressor>,
+};
+
+void RouterModule::processRoute(Chain& chain, int route, juce::dsp::AudioBlock<float>& block, Parameters& params)
+{
+    const auto index = static_cast<size_t>(juce::jlimit(0, numRoutes - 1, route));
+    (this->*routeTable[index])(chain, block, params);
+}
+
+int RouterModule::computeLatencySamples() const
+{
+    const auto& chain = activeChain();
+
+    // Report latency from Soothe module (unless bypassed with latency dropped)
+    if (chain.sootheBypass.isLatencyDropped())
+        return 0;
+
+    return chain.soothe.getLatencySamples();
+}
+
+bool RouterModule::needsBackgroundThreads() const
+{
+    for (const auto& chain : chains)
+        if (chain.soothe.needsBackgroundThreads())
+            return true;
+
+    return false;
+}
+
+void RouterModule::startBackgroundThreads()
+{
+    for (auto& chain : chains)
+        chain.soothe.startBackgroundThreads();
+}
+
+int RouterModule::computeTailSamples() const
+{
+    const auto& chain = activeChain();
+
+    // Modules are in series, so the tails add up
+    return chain.compressor.getTailSamples() + chain.color.getTailSamples() + chain.soothe.getTailSamples();
 }
 
-int RouterModule::getLatencySamples() const
+void RouterModule::publishLatencyAndTail()
 {
-    // Report latency from Soothe module
-    return soothe.getLatencySamples();
+    // The active chain and its modules' settings only change on the audio
+    // thread; hosts and offline renderers read these copies instead
+    latencySamples.store(computeLatencySamples(), std::memory_order_relaxed);
+    tailSamples.store(computeTailSamples(), std::memory_order_relaxed);
 }
@@ -5,38 +5,161 @@
 #include "CompressorModule.h"
 #include "ColorModule.h"
 #include "SootheModule.h"
+#include "SilenceDetector.h"
+#include "LoudnessMeter.h"
+#include "ProcessingProfiler.h"
+#include "ModuleBypass.h"
+#include "Metering.h"
 #include "../Parameters.h"
+#include <array>
+#include <atomic>
 
 /**
  * Manages signal routing between the three main modules
- * Supports two routing options:
- *   A) Soothe → Compressor → Color (default)
- *   B) Compressor → Color → Soothe
+ * Any ordering of Soothe, Compressor and Color can be selected. Each
+ * ordering is a separately instantiated chain function, picked once per
+ * block from a table indexed by the routing parameter.
+ * Module bypass is owned here: toggles crossfade, and a bypassed module
+ * does not run (only a delay line that keeps the latency constant)
+ *
+ * Route changes run the outgoing and incoming orderings side by side on
+ * two preallocated chains: the incoming chain takes over the outgoing
+ * chain's state, the two outputs crossfade, then the old chain goes idle.
  */
 class RouterModule
 {
 public:
     RouterModule();
 
+    // Processing stages. New stages (limiter, multiband) get an enumerator,
+    // a case in processStage() and entries in the route table.
+    enum class Stage
+    {
+        Soothe,
+        Compressor,
+        Color
+    };
+
+    static constexpr int numRoutes = 6;
+
     void prepare(const juce::dsp::ProcessSpec& spec);
     void reset();
     void process(juce::dsp::ProcessContextReplacing<float>& context, Parameters& params);
 
-    float getGainReduction() const { return compressor.getGainReduction(); }
-    int getLatencySamples() const;
+    // Levels and GR range of the last block, gathered during processing
+    const MeterFrame& getMeterFrame() const { return meterFrame; }
+
+    // The active chain's latency and tail as of the last block (any thread)
+    int getLatencySamples() const { return latencySamples.load(std::memory_order_relaxed); }
+    int getTailSamples() const { return tailSamples.load(std::memory_order_relaxed); }
+
+    // Soothe scheduling that needs a thread asks for it from the audio
+    // thread; the thread is started from the message thread
+    bool needsBackgroundThreads() const;
+    void startBackgroundThreads();
+
+    // Loudness of the router input (before trim) and output (after trim)
+    const LoudnessReadings& getInputLoudness() const { return inputLoudness.getReadings(); }
+    const LoudnessReadings& getOutputLoudness() const { return outputLoudness.getReadings(); }
+    void resetLoudness();
+
+    // Idle detection
+    bool isSleeping() const { return silenceDetector.isSleeping(); }
+    juce::int64 getNumSkippedBlocks() const { return silenceDetector.getNumSkippedBlocks(); }
+
+    bool isRouteTransitioning() const { return targetRoute >= 0; }
+
+    // Chains run by the last block: 2 during a route crossfade, 0 asleep
+    int getNumChainsProcessed() const { return numChainsProcessed.load(std::memory_order_relaxed); }
+
+    // Per-module CPU time; disabled (and free) unless switched on
+    ProcessingProfiler& getProfiler() { return profiler; }
+
+    // Soothe's spectrum and curves; published only while enabled
+    SootheDisplay& getSootheDisplay() { return sootheDisplay; }
+
+    // Decimated compressor GR trace; fed only while enabled
+    GainReductionHistory& getGainReductionHistory() { return grHistory; }
 
 private:
-    CompressorModule compressor;
-    ColorModule color;
-    SootheModule soothe;
+    struct Chain
+    {
+        CompressorModule compressor;
+        ColorModule color;
+        SootheModule soothe;
+
+        ModuleBypass compBypass;
+        ModuleBypass colorBypass;
+        ModuleBypass sootheBypass;
+
+        void prepare(const juce::dsp::ProcessSpec& spec);
+        void reset();
+        bool copyStateFrom(const Chain& other);
+    };
+
+    // Two chains: the active one, and a shadow used during route changes.
+    // Audio thread only; other threads read the snapshots below.
+    std::array<Chain, 2> chains;
+    int activeChainIndex = 0;
+
+    Chain& activeChain() { return chains[static_cast<size_t>(activeChainIndex)]; }
+    const Chain& activeChain() const { return chains[static_cast<size_t>(activeChainIndex)]; }
+    Chain& shadowChain() { return chains[static_cast<size_t>(1 - activeChainIndex)]; }
+
+    SilenceDetector silenceDetector;
+    LoudnessMeter inputLoudness;
+    LoudnessMeter outputLoudness;
 
     // Global trim
     juce::dsp::Gain<float> inputGain;
-    juce::dsp::Gain<float> outputGain;
+    juce::SmoothedValue<float> outputGain;
+
+    MeterFrame meterFrame;
+    ProcessingProfiler profiler;
+    SootheDisplay sootheDisplay;
+    GainReductionHistory grHistory;
 
     double sampleRate = 44100.0;
 
+    // Route transition
+    juce::AudioBuffer<float> transitionBuffer;
+    int currentRoute = -1;
+    int targetRoute = -1;
+    int transitionRemaining = 0;
+    int transitionLength = 0;
+
+    // Taken at the end of every block, prepare() and reset()
+    std::atomic<int> latencySamples{0};
+    std::atomic<int> tailSamples{0};
+    std::atomic<int> numChainsProcessed{0};
+
+    void resetModules();
+    int computeLatencySamples() const;
+    int computeTailSamples() const;
+    void publishLatencyAndTail();
+    void updateBypassStates(Chain& chain, const Parameters& params);
+    void updateGainReductionMeter();
+    void processOutputTrim(juce::dsp::AudioBlock<float>& block, float gainDB);
+    void beginRouteTransition(int newRoute);
+    void processRouteTransition(juce::dsp::AudioBlock<float>& block, Parameters& params);
+
+    template <typename Module>
+    void processModule(Module& module, ModuleBypass& bypass,
+                       juce::dsp::AudioBlock<float>& block, Parameters& params);
+
+    static ProcessingProfiler::Slot getProfilerSlot(Stage stage);
+    static const char* getStageName(Stage stage);
+
+    template <Stage stage>
+    void processStage(Chain& chain, juce::dsp::AudioBlock<float>& block, Parameters& params);
+
     // Routing
-    void processRouteA(juce::dsp::AudioBlock<float>& block, Parameters& params);
-    void processRouteB(juce::dsp::AudioBlock<float>& block, Parameters& params);
+    using ChainFunction = void (RouterModule::*)(Chain&, juce::dsp::AudioBlock<float>&, Parameters&);
+
+    template <Stage... stages>
+    void processChain(Chain& chain, juce::dsp::AudioBlock<float>& block, Parameters& params);
+
+    static const std::array<ChainFunction, numRoutes> routeTable;
+
+    void processRoute(Chain& chain, int route, juce::dsp::AudioBlock<float>& block, Parameters& params);
 };
@@ -0,0 +1,89 @@
+#include "SilenceDetector.h"
+#include <cmath>
+#include <algorithm>
+
+SilenceDetector::SilenceDetector()
+{
+}
+
+void SilenceDetector::prepare(const juce::dsp::ProcessSpec&)
+{
+    // -120 dBFS: well below 24-bit dither, above denormal territory
+    threshold = juce::Decibels::decibelsToGain(-120.0f);
+
+    reset();
+}
+
+void SilenceDetector::reset()
+{
+    silentSamples = 0;
+    sleeping = false;
+    justFellAsleep = false;
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        peakLevel[ch] = 0.0f;
+        rmsLevel[ch] = 0.0f;
+    }
+
+    skippedBlocks.store(0, std::memory_order_relaxed);
+}
+
+bool SilenceDetector::process(const juce::dsp::AudioBlock<float>& block)
+{
+    justFellAsleep = false;
+
+    const int numChannels = std::min(2, static_cast<int>(block.getNumChannels()));
+    const int numSamples = static_cast<int>(block.getNumSamples());
+
+    // One pass per channel gives the gate decision and the input meter
+    float peak = 0.0f;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto* data = block.getChannelPointer(static_cast<size_t>(ch));
+        float channelPeak = 0.0f;
+        float sumSquares = 0.0f;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            channelPeak = std::max(channelPeak, std::abs(data[i]));
+            sumSquares += data[i] * data[i];
+        }
+
+        peakLevel[ch] = channelPeak;
+        rmsLevel[ch] = numSamples > 0 ? std::sqrt(sumSquares / static_cast<float>(numSamples)) : 0.0f;
+        peak = std::max(peak, channelPeak);
+    }
+
+    // Mono: mirror so stereo meters read the same on both sides
+    if (numChannels == 1)
+    {
+        peakLevel[1] = peakLevel[0];
+        rmsLevel[1] = rmsLevel[0];
+    }
+
+    if (peak > threshold)
+    {
+        // Any signal wakes the chain for the whole block. The samples ahead of
+        // the onset are silent and the chain was reset when it went to sleep,
+        // so the first audible sample is processed exactly where it lands.
+        silentSamples = 0;
+        sleeping = false;
+        return true;
+    }
+
+    silentSamples += numSamples;
+
+    if (silentSamples <= tailSamples)
+        return true;
+
+    if (!sleeping)
+    {
+        sleeping = true;
+        justFellAsleep = true;
+    }
+
+    skippedBlocks.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
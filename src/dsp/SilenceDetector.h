@@ -0,0 +1,45 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <atomic>
+
+/**
+ * Input silence gate for idle instances
+ * Once the input has been silent for longer than the chain's tail, the
+ * processing chain can be skipped until signal returns
+ */
+class SilenceDetector
+{
+public:
+    SilenceDetector();
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    // Longest time any module keeps producing output after its input stops
+    void setTailSamples(int numSamples) { tailSamples = numSamples; }
+
+    // Returns true if the chain must run for this block
+    bool process(const juce::dsp::AudioBlock<float>& block);
+
+    // Input levels of the last block, measured in the same pass
+    float getPeak(int channel) const { return peakLevel[channel]; }
+    float getRMS(int channel) const { return rmsLevel[channel]; }
+
+    bool isSleeping() const { return sleeping; }
+    bool hasJustFallenAsleep() const { return justFellAsleep; }
+    juce::int64 getNumSkippedBlocks() const { return skippedBlocks.load(std::memory_order_relaxed); }
+
+private:
+    float threshold = 0.0f;
+    float peakLevel[2] = {0.0f, 0.0f};
+    float rmsLevel[2] = {0.0f, 0.0f};
+
+    int tailSamples = 0;
+    juce::int64 silentSamples = 0;
+
+    bool sleeping = false;
+    bool justFellAsleep = false;
+
+    std::atomic<juce::int64> skippedBlocks{0};
+};
@@ -0,0 +1,344 @@
+#include "SootheAnalyser.h"
+#include <cmath>
+#include <algorithm>
+
+SootheAnalyser::Settings SootheAnalyser::Settings::fromParameters(const Parameters& params)
+{
+    Settings settings;
+    settings.amount = params.getValue(ParamIDs::sootheAmount) * 0.01f;
+    settings.sensitivity = params.getValue(ParamIDs::sootheSensitivity) * 0.01f;
+    settings.sharpness = params.getValue(ParamIDs::sootheSharpness) * 0.01f;
+    settings.speed = params.getValue(ParamIDs::sootheSpeed) * 0.01f;
+    settings.focusLow = params.getValue(ParamIDs::sootheFocusLow);
+    settings.focusHigh = params.getValue(ParamIDs::sootheFocusHigh);
+    settings.scale = static_cast<Scale>(params.getIntValue(ParamIDs::sootheAnalysis));
+    return settings;
+}
+
+void SootheAnalyser::reserve(int maxSize)
+{
+    const auto numBins = static_cast<size_t>(maxSize / 2 + 1);
+    constexpr size_t maxBands = 256;
+
+    for (auto* buffer : {&baseline, &resonanceScore, &attenuation, &smoothedAttenuation, &binERB, &binFraction})
+        buffer->reserve(numBins);
+
+    binBand.reserve(numBins);
+
+    // Triangles overlap their neighbours, so each bin is in at most two;
+    // bands narrower than a bin take two more
+    weights.reserve(2 * numBins + 2 * maxBands);
+    bandWeights.reserve(maxBands);
+
+    for (auto* buffer : {&bandFrequencies, &bandMagnitudes, &bandBaseline, &bandScore, &bandAttenuation, &smoothedBandAttenuation})
+        buffer->reserve(maxBands);
+}
+
+void SootheAnalyser::prepare(int newFFTSize, double newSampleRate, float targetBinHz)
+{
+    fftSize = newFFTSize;
+    sampleRate = newSampleRate;
+    targetResolution = targetBinHz;
+    widthScale = targetBinHz / (static_cast<float>(sampleRate) / static_cast<float>(fftSize));
+
+    const auto numBins = static_cast<size_t>(fftSize / 2 + 1);
+    baseline.resize(numBins, 0.0f);
+    resonanceScore.resize(numBins, 0.0f);
+    attenuation.resize(numBins, 1.0f);
+    smoothedAttenuation.resize(numBins, 1.0f);
+
+    prepareBands();
+    reset();
+}
+
+void SootheAnalyser::prepareBands()
+{
+    const int numBins = fftSize / 2 + 1;
+    const int numBands = juce::jlimit(128, 256, numBins / 4);
+    const float binHz = static_cast<float>(sampleRate) / static_cast<float>(fftSize);
+
+    // Band centres evenly spaced in ERB-rate between 20 Hz and Nyquist
+    const float erbLow = hzToERB(20.0f);
+    const float erbHigh = hzToERB(static_cast<float>(sampleRate) * 0.5f);
+    const float spacing = (erbHigh - erbLow) / static_cast<float>(numBands);
+    bandsPerERB = 1.0f / spacing;
+
+    auto bandCentre = [&](int band) { return erbLow + (static_cast<float>(band) + 0.5f) * spacing; };
+
+    bandWeights.assign(static_cast<size_t>(numBands), {});
+    bandFrequencies.resize(static_cast<size_t>(numBands));
+    weights.clear();
+
+    binERB.resize(static_cast<size_t>(numBins));
+    for (int k = 0; k < numBins; ++k)
+        binERB[static_cast<size_t>(k)] = hzToERB(static_cast<float>(k) * binHz);
+
+    // Bands move up monotonically, so each search starts at the last band's bins
+    int searchStart = 0;
+
+    for (int b = 0; b < numBands; ++b)
+    {
+        const float centre = bandCentre(b);
+        const float frequency = (std::pow(10.0f, centre / 21.4f) - 1.0f) / 0.00437f;
+        bandFrequencies[static_cast<size_t>(b)] = frequency;
+
+        auto& band = bandWeights[static_cast<size_t>(b)];
+        band.firstWeight = static_cast<int>(weights.size());
+
+        // Triangle reaching zero at the neighbouring band centres
+        float sum = 0.0f;
+        for (int k = searchStart; k < numBins; ++k)
+        {
+            const float w = 1.0f - std::abs(binERB[static_cast<size_t>(k)] - centre) / spacing;
+
+            if (w <= 0.0f)
+            {
+                if (band.numBins > 0)
+                    break;
+                continue;
+            }
+
+            if (band.numBins == 0)
+                band.firstBin = k;
+
+            weights.push_back(w);
+            ++band.numBins;
+            sum += w;
+        }
+
+        // Narrower than a bin (low bands at small FFT sizes): interpolate
+        // between the two bins around the centre instead
+        if (band.numBins == 0)
+        {
+            const float position = frequency / binHz;
+            band.firstBin = std::min(static_cast<int>(position), numBins - 2);
+            band.numBins = 2;
+
+            const float fraction = position - static_cast<float>(band.firstBin);
+            weights.push_back(1.0f - fraction);
+            weights.push_back(fraction);
+            sum = 1.0f;
+        }
+        else
+        {
+            searchStart = band.firstBin;
+        }
+
+        for (int i = 0; i < band.numBins; ++i)
+            weights[static_cast<size_t>(band.firstWeight + i)] /= sum;
+    }
+
+    // Each bin's fractional position on the band grid
+    binBand.resize(static_cast<size_t>(numBins));
+    binFraction.resize(static_cast<size_t>(numBins));
+
+    for (int k = 0; k < numBins; ++k)
+    {
+        const float position = juce::jlimit(0.0f, static_cast<float>(numBands - 1),
+                                            (binERB[static_cast<size_t>(k)] - erbLow) / spacing - 0.5f);
+        const int band = std::min(static_cast<int>(position), numBands - 2);
+
+        binBand[static_cast<size_t>(k)] = band;
+        binFraction[static_cast<size_t>(k)] = position - static_cast<float>(band);
+    }
+
+    bandMagnitudes.resize(static_cast<size_t>(numBands), 0.0f);
+    bandBaseline.resize(static_cast<size_t>(numBands), 0.0f);
+    bandScore.resize(static_cast<size_t>(numBands), 0.0f);
+    bandAttenuation.resize(static_cast<size_t>(numBands), 1.0f);
+    smoothedBandAttenuation.resize(static_cast<size_t>(numBands), 1.0f);
+}
+
+void SootheAnalyser::reset()
+{
+    std::fill(baseline.begin(), baseline.end(), 0.0f);
+    std::fill(resonanceScore.begin(), resonanceScore.end(), 0.0f);
+    std::fill(attenuation.begin(), attenuation.end(), 1.0f);
+    std::fill(bandAttenuation.begin(), bandAttenuation.end(), 1.0f);
+    unity = true;
+}
+
+void SootheAnalyser::analyse(const float* magnitudes, const Settings& settings)
+{
+    // Each domain keeps its own release state: start the new one from unity
+    if (settings.scale != lastScale)
+    {
+        std::fill(attenuation.begin(), attenuation.end(), 1.0f);
+        std::fill(bandAttenuation.begin(), bandAttenuation.end(), 1.0f);
+        lastScale = settings.scale;
+    }
+
+    if (settings.scale == Scale::ERB)
+    {
+        analyseBands(magnitudes, settings);
+        return;
+    }
+
+    const int numBins = fftSize / 2 + 1;
+
+    // Compute baseline
+    const float smoothingWidth = (5.0f + settings.sharpness * 20.0f) * widthScale;
+    smoothSpectrum(magnitudes, baseline.data(), numBins, static_cast<int>(smoothingWidth));
+
+    // Compute resonance scores
+    computeResonanceScore(magnitudes, baseline.data(), resonanceScore.data(), numBins,
+                          freqToFFTBin(settings.focusLow), freqToFFTBin(settings.focusHigh), settings.sensitivity);
+
+    // Update attenuation, then smooth across frequency based on sharpness
+    const int smoothWidth = static_cast<int>((1.0f + (1.0f - settings.sharpness) * 5.0f) * widthScale);
+    unity = updateAttenuation(resonanceScore.data(), attenuation, smoothedAttenuation, settings.amount, settings.speed, smoothWidth);
+}
+
+void SootheAnalyser::analyseBands(const float* magnitudes, const Settings& settings)
+{
+    const int numBands = getNumBands();
+
+    // Bins -> bands through the sparse weights
+    for (int b = 0; b < numBands; ++b)
+    {
+        const auto& band = bandWeights[static_cast<size_t>(b)];
+        const float* w = weights.data() + band.firstWeight;
+        const float* m = magnitudes + band.firstBin;
+        float sum = 0.0f;
+
+        for (int i = 0; i < band.numBins; ++i)
+            sum += w[i] * m[i];
+
+        bandMagnitudes[static_cast<size_t>(b)] = sum;
+    }
+
+    // Same shape as the linear analysis, with widths in ERB instead of bins
+    const int baselineWidth = std::max(1, juce::roundToInt((0.75f + settings.sharpness * 2.25f) * bandsPerERB));
+    smoothSpectrum(bandMagnitudes.data(), bandBaseline.data(), numBands, baselineWidth);
+
+    const auto focusBegin = std::lower_bound(bandFrequencies.begin(), bandFrequencies.end(), settings.focusLow);
+    const auto focusEnd = std::upper_bound(bandFrequencies.begin(), bandFrequencies.end(), settings.focusHigh);
+    computeResonanceScore(bandMagnitudes.data(), bandBaseline.data(), bandScore.data(), numBands,
+                          static_cast<int>(focusBegin - bandFrequencies.begin()),
+                          static_cast<int>(focusEnd - bandFrequencies.begin()) - 1, settings.sensitivity);
+
+    const int smoothWidth = juce::roundToInt((0.1f + (1.0f - settings.sharpness) * 0.5f) * bandsPerERB);
+    unity = updateAttenuation(bandScore.data(), bandAttenuation, smoothedBandAttenuation, settings.amount, settings.speed, smoothWidth);
+
+    if (unity)
+    {
+        std::fill(attenuation.begin(), attenuation.end(), 1.0f);
+        return;
+    }
+
+    // Bands -> bins, interpolating between neighbouring band centres
+    for (size_t k = 0; k < attenuation.size(); ++k)
+    {
+        const auto band = static_cast<size_t>(binBand[k]);
+        attenuation[k] = bandAttenuation[band] + (bandAttenuation[band + 1] - bandAttenuation[band]) * binFraction[k];
+    }
+}
+
+float SootheAnalyser::getBaseline(int bin) const
+{
+    const auto k = static_cast<size_t>(bin);
+
+    if (lastScale == Scale::Linear)
+        return baseline[k];
+
+    const auto band = static_cast<size_t>(binBand[k]);
+    return bandBaseline[band] + (bandBaseline[band + 1] - bandBaseline[band]) * binFraction[k];
+}
+
+void SootheAnalyser::computeResonanceScore(const float* magnitudes, const float* reference, float* scores,
+                                           int size, int first, int last, float sensitivity)
+{
+    for (int k = 0; k < size; ++k)
+    {
+        // Outside focus range
+        if (k < first || k > last)
+        {
+            scores[k] = 0.0f;
+            continue;
+        }
+
+        // Ratio of magnitude to baseline
+        const float ratio = magnitudes[k] / (reference[k] + 1e-10f);
+
+        // Resonance score
+        float score = std::max(0.0f, ratio - 1.0f);
+        score = std::pow(score, 1.5f);  // Selectivity
+
+        scores[k] = score * sensitivity;
+    }
+}
+
+bool SootheAnalyser::updateAttenuation(const float* scores, std::vector<float>& gains,
+                                       std::vector<float>& scratch, float amount, float speed, int smoothWidth)
+{
+    // Within -0.001 dB of unity, both target and gain, counts as settled
+    constexpr float settledGain = 0.9999f;
+
+    const float maxAttnDB = -12.0f * amount;
+    const float attackCoeff = 0.1f + speed * 0.4f;
+    const float releaseCoeff = 0.01f + speed * 0.09f;
+    const int size = static_cast<int>(gains.size());
+    bool settled = true;
+
+    for (int k = 0; k < size; ++k)
+    {
+        // Target attenuation in dB (no resonance: unity, without the pow)
+        float targetAttn = 1.0f;
+
+        if (scores[k] > 0.0f)
+        {
+            const float targetAttnDB = -scores[k] * 12.0f * amount;
+            const float clampedAttnDB = std::max(targetAttnDB, maxAttnDB);
+            targetAttn = juce::Decibels::decibelsToGain(clampedAttnDB);
+        }
+
+        // Smooth attenuation over time
+        const float coeff = (targetAttn < gains[k]) ? attackCoeff : releaseCoeff;
+        gains[k] += (targetAttn - gains[k]) * coeff;
+
+        // Clamp
+        gains[k] = std::clamp(gains[k], 0.1f, 1.0f);
+
+        settled = settled && std::min(targetAttn, gains[k]) >= settledGain;
+    }
+
+    if (settled)
+    {
+        std::fill(gains.begin(), gains.end(), 1.0f);
+        return true;
+    }
+
+    // Frequency smoothing (scratch buffer, no allocation)
+    smoothSpectrum(gains.data(), scratch.data(), size, smoothWidth);
+    std::swap(gains, scratch);
+    return false;
+}
+
+void SootheAnalyser::smoothSpectrum(const float* input, float* output, int size, int width)
+{
+    // Moving average, truncated at the edges
+    for (int k = 0; k < size; ++k)
+    {
+        float sum = 0.0f;
+        int count = 0;
+
+        for (int n = std::max(0, k - width); n <= std::min(size - 1, k + width); ++n)
+        {
+            sum += input[n];
+            count++;
+        }
+
+        output[k] = (count > 0) ? sum / static_cast<float>(count) : input[k];
+    }
+}
+
+float SootheAnalyser::hzToERB(float frequency)
+{
+    // Glasberg & Moore ERB-rate scale
+    return 21.4f * std::log10(1.0f + 0.00437f * frequency);
+}
+
+int SootheAnalyser::freqToFFTBin(float freq) const
+{
+    return static_cast<int>((freq / static_cast<float>(sampleRate)) * static_cast<float>(fftSize));
+}
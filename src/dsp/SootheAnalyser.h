@@ -0,0 +1,114 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include "../Parameters.h"
+#include <vector>
+
+/**
+ * Resonance analysis for Soothe
+ * Turns one frame's magnitude spectrum into a per-bin attenuation curve,
+ * smoothed over time. Holds no FFT state, so it can run on the audio thread
+ * or on an analysis worker. The analysis runs either on the FFT bins
+ * themselves or on ERB-spaced bands, which are then interpolated back to bins.
+ */
+class SootheAnalyser
+{
+public:
+    static constexpr int maxFFTSize = 8192;  // High at 192 kHz
+    static constexpr int maxBins = maxFFTSize / 2 + 1;
+
+    enum class Scale
+    {
+        Linear = 0,  // Every FFT bin
+        ERB          // 128-256 bands, evenly spaced on the ERB-rate scale
+    };
+
+    struct Settings
+    {
+        float amount = 0.5f;       // 0-1
+        float sensitivity = 0.5f;  // 0-1
+        float sharpness = 0.5f;    // 0-1
+        float speed = 0.5f;        // 0-1
+        float focusLow = 20.0f;    // Hz
+        float focusHigh = 20000.0f;
+        Scale scale = Scale::Linear;
+
+        static Settings fromParameters(const Parameters& params);
+    };
+
+    // Allocates for FFT sizes up to maxSize; prepare() within it does not
+    void reserve(int maxSize);
+
+    // targetBinHz is the resolution the quality asks for; bin-based widths
+    // are scaled by how far the actual FFT size lands from it. Allocates
+    // unless reserve() covered this size.
+    void prepare(int newFFTSize, double newSampleRate, float targetBinHz);
+    void reset();
+
+    void analyse(const float* magnitudes, const Settings& settings);
+
+    const std::vector<float>& getAttenuation() const { return attenuation; }
+
+    // Baseline the last frame was measured against, at an FFT bin
+    float getBaseline(int bin) const;
+
+    // Every bin exactly 1 and nothing left to release: the frame can skip
+    // applying the curve altogether
+    bool isUnity() const { return unity; }
+    int getFFTSize() const { return fftSize; }
+    float getTargetBinHz() const { return targetResolution; }
+    int getNumBands() const { return static_cast<int>(bandFrequencies.size()); }
+    double getSampleRate() const { return sampleRate; }
+
+private:
+    std::vector<float> baseline;
+    std::vector<float> resonanceScore;
+    std::vector<float> attenuation;
+    std::vector<float> smoothedAttenuation;
+
+    // ERB band domain: each band is a triangular, normalised weighting of
+    // the bins around its centre, stored sparsely
+    struct BandWeights
+    {
+        int firstBin = 0;
+        int numBins = 0;
+        int firstWeight = 0;
+    };
+
+    std::vector<BandWeights> bandWeights;
+    std::vector<float> weights;
+    std::vector<float> bandFrequencies;
+    float bandsPerERB = 1.0f;
+
+    // Where each bin sits between band centres, for expanding back to bins
+    std::vector<float> binERB;
+    std::vector<int> binBand;
+    std::vector<float> binFraction;
+
+    std::vector<float> bandMagnitudes;
+    std::vector<float> bandBaseline;
+    std::vector<float> bandScore;
+    std::vector<float> bandAttenuation;
+    std::vector<float> smoothedBandAttenuation;
+
+    int fftSize = 0;
+    double sampleRate = 44100.0;
+    float targetResolution = 0.0f;
+    float widthScale = 1.0f;  // Linear analysis widths are tuned in target bins
+    Scale lastScale = Scale::Linear;
+    bool unity = true;
+
+    void prepareBands();
+    void analyseBands(const float* magnitudes, const Settings& settings);
+
+    // Shared by both domains: values[0, size) with focus range [first, last]
+    static void computeResonanceScore(const float* magnitudes, const float* reference, float* scores,
+                                      int size, int first, int last, float sensitivity);
+    // Returns true, with gains snapped to 1, once nothing is attenuated
+    static bool updateAttenuation(const float* scores, std::vector<float>& gains,
+                                  std::vector<float>& scratch, float amount, float speed, int smoothWidth);
+
+    static void smoothSpectrum(const float* input, float* output, int size, int width);
+    static float hzToERB(float frequency);
+    int freqToFFTBin(float freq) const;
+};
@@ -0,0 +1,113 @@
+#include "SootheAnalysisWorker.h"
+#include <algorithm>
+#include <chrono>
+
+SootheAnalysisWorker::SootheAnalysisWorker()
+    : juce::Thread("Soothe analysis")
+{
+    // Every buffer that changes hands is sized for the largest FFT, so
+    // neither side allocates when quality changes
+    for (int i = 0; i < numJobSlots; ++i)
+    {
+        jobSlots[static_cast<size_t>(i)].slot = i;
+        jobSlots[static_cast<size_t>(i)].magnitudes.reserve(SootheAnalyser::maxBins);
+        freeJobs.push(i);
+    }
+
+    for (int i = 0; i < numResultSlots; ++i)
+    {
+        resultSlots[static_cast<size_t>(i)].slot = i;
+        resultSlots[static_cast<size_t>(i)].attenuation.reserve(SootheAnalyser::maxBins);
+        freeResults.push(i);
+    }
+}
+
+SootheAnalysisWorker::~SootheAnalysisWorker()
+{
+    signalThreadShouldExit();
+    jobReady.release();
+    stopThread(1000);
+}
+
+void SootheAnalysisWorker::start()
+{
+    if (isThreadRunning())
+        return;
+
+    // Real-time scheduling needs privileges on some systems
+    if (!startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(8)))
+        startThread(juce::Thread::Priority::highest);
+}
+
+SootheAnalysisWorker::Job* SootheAnalysisWorker::beginJob()
+{
+    int index = 0;
+    return freeJobs.pop(index) ? &jobSlots[static_cast<size_t>(index)] : nullptr;
+}
+
+void SootheAnalysisWorker::submit(Job& job)
+{
+    // Only numJobSlots indices exist, so this cannot overflow
+    queuedJobs.push(job.slot);
+    jobReady.release();
+}
+
+SootheAnalysisWorker::Result* SootheAnalysisWorker::fetch()
+{
+    int index = 0;
+    return readyResults.pop(index) ? &resultSlots[static_cast<size_t>(index)] : nullptr;
+}
+
+void SootheAnalysisWorker::recycle(Result& result)
+{
+    freeResults.push(result.slot);
+}
+
+void SootheAnalysisWorker::run()
+{
+    while (!threadShouldExit())
+    {
+        if (!jobReady.try_acquire_for(std::chrono::milliseconds(100)))
+            continue;
+
+        int index = 0;
+
+        while (queuedJobs.pop(index))
+        {
+            auto& job = jobSlots[static_cast<size_t>(index)];
+            analyse(job);
+            freeJobs.push(index);
+        }
+    }
+}
+
+void SootheAnalysisWorker::analyse(Job& job)
+{
+    auto& analyser = analysers[static_cast<size_t>(job.channel)];
+
+    // Quality or sample rate changed: resizing is fine on this thread
+    if (analyser.getFFTSize() != job.fftSize || analyser.getSampleRate() != job.sampleRate
+        || analyser.getTargetBinHz() != job.targetBinHz)
+        analyser.prepare(job.fftSize, job.sampleRate, job.targetBinHz);
+    else if (job.reset)
+        analyser.reset();
+
+    analyser.analyse(job.magnitudes.data(), job.settings);
+
+    // Audio thread only wants the latest curve; drop if it stopped reading
+    int index = 0;
+    if (!freeResults.pop(index))
+        return;
+
+    auto& result = resultSlots[static_cast<size_t>(index)];
+    const auto& attenuation = analyser.getAttenuation();
+
+    result.channel = job.channel;
+    result.fftSize = job.fftSize;
+    result.unity = analyser.isUnity();
+    // The analyser keeps its curve for smoothing, so it is copied; the slot
+    // has room for the largest FFT, so this never allocates
+    result.attenuation.assign(attenuation.begin(), attenuation.end());
+
+    readyResults.push(index);
+}
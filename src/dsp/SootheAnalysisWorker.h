@@ -0,0 +1,91 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "SootheAnalyser.h"
+#include "LockFreeFifo.h"
+#include <array>
+#include <semaphore>
+#include <vector>
+
+/**
+ * Runs Soothe's resonance analysis off the audio thread
+ * The audio thread submits each frame's magnitudes and settings and, a hop
+ * later, applies whichever attenuation curve the worker published last.
+ * Jobs and results live in slots preallocated for the largest FFT; the
+ * single-producer/single-consumer FIFOs only pass slot indices. Magnitudes
+ * and curves are copied into the slots (allocation-free, not copy-free),
+ * and the audio thread takes a result's curve by swapping vectors. Waking
+ * the worker never takes a lock.
+ */
+class SootheAnalysisWorker : private juce::Thread
+{
+public:
+    static constexpr int maxChannels = 2;
+
+    struct Job
+    {
+        int channel = 0;
+        int fftSize = 0;
+        double sampleRate = 44100.0;
+        float targetBinHz = 0.0f;
+        bool reset = false;  // Start the channel's smoothing from scratch
+        SootheAnalyser::Settings settings;
+        std::vector<float> magnitudes;  // fftSize / 2 + 1 bins
+
+    private:
+        friend class SootheAnalysisWorker;
+        int slot = 0;
+    };
+
+    struct Result
+    {
+        int channel = 0;
+        int fftSize = 0;
+        bool unity = true;
+        std::vector<float> attenuation;  // Reserved for maxBins; swap it out
+
+    private:
+        friend class SootheAnalysisWorker;
+        int slot = 0;
+    };
+
+    SootheAnalysisWorker();
+    ~SootheAnalysisWorker() override;
+
+    void start();
+
+    // Audio thread. beginJob() returns a free slot to fill, or nullptr when
+    // the worker has fallen behind (frame not analysed); submit() hands it over.
+    Job* beginJob();
+    void submit(Job& job);
+
+    // Audio thread. fetch() returns the oldest unread result, or nullptr;
+    // recycle() gives its slot back once the caller is done with it.
+    Result* fetch();
+    void recycle(Result& result);
+
+private:
+    static constexpr int numJobSlots = 4;
+    static constexpr int numResultSlots = 8;
+
+    std::array<Job, numJobSlots> jobSlots;
+    std::array<Result, numResultSlots> resultSlots;
+
+    // Slot indices: free ones flow back to whoever fills them next
+    LockFreeFifo<int> freeJobs{numJobSlots};
+    LockFreeFifo<int> queuedJobs{numJobSlots};
+    LockFreeFifo<int> freeResults{numResultSlots};
+    LockFreeFifo<int> readyResults{numResultSlots};
+
+    // One permit per submitted job; releasing is a lock-free atomic (and a
+    // futex wake only when the worker is asleep)
+    std::counting_semaphore<> jobReady{0};
+
+    // Worker thread only
+    std::array<SootheAnalyser, maxChannels> analysers;
+
+    void run() override;
+    void analyse(Job& job);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SootheAnalysisWorker)
+};
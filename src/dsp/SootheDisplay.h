@@ -0,0 +1,49 @@
+#pragma once
+
+#include "TripleBuffer.h"
+#include <array>
+#include <atomic>
+#include <cmath>
+
+/**
+ * Soothe's spectrum and attenuation, decimated for the editor
+ * Points are spaced logarithmically from 20 Hz to 20 kHz. Values are linear:
+ * magnitude and baseline are scaled so a full-scale sine reads 1, attenuation
+ * is the deepest gain across the bins each point covers.
+ */
+struct SootheDisplayFrame
+{
+    static constexpr int numPoints = 256;
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+
+    std::array<float, numPoints> magnitude{};
+    std::array<float, numPoints> baseline{};
+    std::array<float, numPoints> attenuation{};
+
+    // Worker scheduling analyses off the audio thread and has no baseline
+    bool hasBaseline = false;
+
+    // Frequency at a position 0-1 along the display
+    static float getFrequency(float position)
+    {
+        return minFrequency * std::pow(maxFrequency / minFrequency, position);
+    }
+};
+
+/**
+ * Hands display frames from the audio thread to the editor
+ * Soothe only decimates and publishes while an editor has enabled it.
+ */
+class SootheDisplay
+{
+public:
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    TripleBuffer<SootheDisplayFrame>& getFrames() { return frames; }
+
+private:
+    std::atomic<bool> enabled{false};
+    TripleBuffer<SootheDisplayFrame> frames;
+};
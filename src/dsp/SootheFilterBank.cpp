@@ -0,0 +1,302 @@
+#include "SootheFilterBank.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float minDipDB = -0.5f;       // Shallower dips get no filter
+    constexpr float flatDB = -0.05f;        // A band this close to 0 dB is off
+    constexpr float matchOctaves = 0.33f;   // A peak this close keeps its band
+}
+
+void SootheFilterBank::prepare(double newSampleRate, int newHopSize)
+{
+    sampleRate = newSampleRate;
+    stepsPerHop = std::max(1, newHopSize / subBlockSize);
+    reset();
+}
+
+void SootheFilterBank::reset()
+{
+    for (auto& channelBands : bands)
+    {
+        for (auto& band : channelBands)
+        {
+            band = {};
+            band.current.pitch = band.target.pitch = std::log2(1000.0f);
+            updateCoefficients(band);
+        }
+    }
+
+    // Lanes beyond the channels stay a silent pass-through
+    for (auto& lane : laneBands)
+    {
+        lane.a1 = Lanes::expand(1.0f);
+        lane.a2 = lane.a3 = lane.m1 = Lanes::expand(0.0f);
+        lane.ic1eq = lane.ic2eq = lane.keepState = Lanes::expand(0.0f);
+    }
+
+    packLanes();
+    subBlockPosition = 0;
+}
+
+int SootheFilterBank::getNumActiveBands(int channel) const
+{
+    const auto& channelBands = bands[static_cast<size_t>(channel)];
+    return static_cast<int>(std::count_if(channelBands.begin(), channelBands.end(), [](const Band& b) { return b.active; }));
+}
+
+void SootheFilterBank::setTargets(int channel, const float* attenuation, int fftSize)
+{
+    auto& channelBands = bands[static_cast<size_t>(channel)];
+    std::array<Peak, maxBands> peaks;
+    const int numPeaks = findPeaks(attenuation, fftSize, peaks);
+
+    assignPeaks(channelBands, peaks, numPeaks);
+
+    // Glide over the coming hop. Channels reach their hop boundaries at
+    // different times, so the sub-block grid they share keeps running.
+    for (auto& band : channelBands)
+    {
+        const auto steps = static_cast<float>(stepsPerHop);
+        band.step.pitch = (band.target.pitch - band.current.pitch) / steps;
+        band.step.gainDB = (band.target.gainDB - band.current.gainDB) / steps;
+        band.step.logQ = (band.target.logQ - band.current.logQ) / steps;
+        band.stepsLeft = stepsPerHop;
+    }
+
+    // Newly claimed bands filter from the next sample
+    packLanes();
+}
+
+int SootheFilterBank::findPeaks(const float* attenuation, int fftSize, std::array<Peak, maxBands>& peaks) const
+{
+    const int numBins = fftSize / 2 + 1;
+    const float binHz = static_cast<float>(sampleRate) / static_cast<float>(fftSize);
+    const int lastBin = std::min(numBins - 2, static_cast<int>(0.45 * sampleRate / binHz));
+    int numPeaks = 0;
+
+    auto toDB = [&](int k) { return juce::Decibels::gainToDecibels(attenuation[k], -60.0f); };
+
+    for (int k = 1; k <= lastBin; ++k)
+    {
+        // Local minima of the curve are resonance centres
+        if (!(attenuation[k] <= attenuation[k - 1] && attenuation[k] < attenuation[k + 1]))
+            continue;
+
+        const float depth = toDB(k);
+        if (depth > minDipDB)
+            continue;
+
+        // Keep the deepest maxBands, sorted deepest first
+        if (numPeaks == maxBands && depth >= peaks[maxBands - 1].gainDB)
+            continue;
+
+        // Parabolic interpolation for the centre frequency
+        const float left = toDB(k - 1);
+        const float right = toDB(k + 1);
+        const float denominator = left - 2.0f * depth + right;
+        const float offset = std::abs(denominator) > 1.0e-6f ? juce::jlimit(-0.5f, 0.5f, 0.5f * (left - right) / denominator) : 0.0f;
+
+        // Q from where the dip is back to half its depth
+        int low = k, high = k;
+        while (low > 0 && toDB(low) < 0.5f * depth)
+            --low;
+        while (high < numBins - 1 && toDB(high) < 0.5f * depth)
+            ++high;
+
+        Peak peak;
+        peak.frequency = std::max(20.0f, (static_cast<float>(k) + offset) * binHz);
+        peak.gainDB = depth;
+        peak.q = juce::jlimit(0.7f, 20.0f, peak.frequency / (static_cast<float>(high - low) * binHz));
+
+        int position = std::min(numPeaks, maxBands - 1);
+        while (position > 0 && peaks[static_cast<size_t>(position - 1)].gainDB > depth)
+        {
+            peaks[static_cast<size_t>(position)] = peaks[static_cast<size_t>(position - 1)];
+            --position;
+        }
+
+        peaks[static_cast<size_t>(position)] = peak;
+        numPeaks = std::min(numPeaks + 1, maxBands);
+    }
+
+    return numPeaks;
+}
+
+void SootheFilterBank::assignPeaks(std::array<Band, maxBands>& channelBands, const std::array<Peak, maxBands>& peaks, int numPeaks)
+{
+    std::array<bool, maxBands> taken{};
+
+    // Bands nobody claims release towards 0 dB where they are
+    for (auto& band : channelBands)
+        band.target.gainDB = 0.0f;
+
+    for (int p = 0; p < numPeaks; ++p)
+    {
+        const auto& peak = peaks[static_cast<size_t>(p)];
+        const float pitch = std::log2(peak.frequency);
+        int chosen = -1;
+
+        // Prefer the band already tracking this resonance...
+        float closest = matchOctaves;
+        for (int b = 0; b < maxBands; ++b)
+        {
+            const float distance = std::abs(channelBands[static_cast<size_t>(b)].target.pitch - pitch);
+
+            if (!taken[static_cast<size_t>(b)] && channelBands[static_cast<size_t>(b)].active && distance < closest)
+            {
+                closest = distance;
+                chosen = b;
+            }
+        }
+
+        // ...otherwise a flat one, which can jump there inaudibly
+        if (chosen < 0)
+        {
+            for (int b = 0; b < maxBands && chosen < 0; ++b)
+            {
+                auto& band = channelBands[static_cast<size_t>(b)];
+
+                if (!taken[static_cast<size_t>(b)] && band.current.gainDB > flatDB)
+                {
+                    band.current.pitch = pitch;
+                    band.current.logQ = std::log2(peak.q);
+                    chosen = b;
+                }
+            }
+        }
+
+        if (chosen < 0)
+            continue;
+
+        auto& band = channelBands[static_cast<size_t>(chosen)];
+        band.target = {pitch, peak.gainDB, std::log2(peak.q)};
+        band.active = true;
+        taken[static_cast<size_t>(chosen)] = true;
+    }
+}
+
+void SootheFilterBank::process(float* left, float* right, int numSamples)
+{
+    int start = 0;
+
+    while (start < numSamples)
+    {
+        if (subBlockPosition == 0)
+            advanceBands();
+
+        const int count = std::min(numSamples - start, subBlockSize - subBlockPosition);
+
+        // Interleave: lane c of frame i is channel c's sample i
+        for (int i = 0; i < count; ++i)
+        {
+            frames[static_cast<size_t>(i * numLanes)] = left[start + i];
+            frames[static_cast<size_t>(i * numLanes + 1)] = right != nullptr ? right[start + i] : 0.0f;
+        }
+
+        // Band by band over the sub-block keeps each band's state in registers
+        for (auto& lane : laneBands)
+        {
+            if (!lane.anyActive)
+                continue;
+
+            const Lanes a1 = lane.a1, a2 = lane.a2, a3 = lane.a3, m1 = lane.m1;
+            Lanes ic1eq = lane.ic1eq, ic2eq = lane.ic2eq;
+
+            for (int i = 0; i < count; ++i)
+            {
+                float* frame = frames.data() + i * numLanes;
+
+                const Lanes v0 = Lanes::fromRawArray(frame);
+                const Lanes v3 = v0 - ic2eq;
+                const Lanes v1 = a1 * ic1eq + a2 * v3;
+                const Lanes v2 = ic2eq + a2 * ic1eq + a3 * v3;
+                ic1eq = v1 * 2.0f - ic1eq;
+                ic2eq = v2 * 2.0f - ic2eq;
+                (v0 + m1 * v1).copyToRawArray(frame);
+            }
+
+            lane.ic1eq = ic1eq * lane.keepState;
+            lane.ic2eq = ic2eq * lane.keepState;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            left[start + i] = frames[static_cast<size_t>(i * numLanes)];
+
+            if (right != nullptr)
+                right[start + i] = frames[static_cast<size_t>(i * numLanes + 1)];
+        }
+
+        subBlockPosition = (subBlockPosition + count) % subBlockSize;
+        start += count;
+    }
+}
+
+void SootheFilterBank::advanceBands()
+{
+    for (auto& channelBands : bands)
+    {
+        for (auto& band : channelBands)
+        {
+            if (band.stepsLeft == 0)
+                continue;
+
+            band.current.pitch += band.step.pitch;
+            band.current.gainDB += band.step.gainDB;
+            band.current.logQ += band.step.logQ;
+
+            // Land exactly on the target
+            if (--band.stepsLeft == 0)
+                band.current = band.target;
+
+            // Released all the way: bypass it (packLanes() drops its state)
+            if (band.current.gainDB > flatDB && band.target.gainDB == 0.0f)
+                band.active = false;
+
+            updateCoefficients(band);
+        }
+    }
+
+    packLanes();
+}
+
+void SootheFilterBank::updateCoefficients(Band& band) const
+{
+    const float frequency = std::min(std::exp2(band.current.pitch), 0.45f * static_cast<float>(sampleRate));
+    const float q = std::exp2(band.current.logQ);
+    const float a = juce::Decibels::decibelsToGain(band.current.gainDB * 0.5f);  // sqrt of the bell's gain
+
+    const float g = std::tan(juce::MathConstants<float>::pi * frequency / static_cast<float>(sampleRate));
+    const float k = 1.0f / (q * a);
+
+    band.a1 = 1.0f / (1.0f + g * (g + k));
+    band.a2 = g * band.a1;
+    band.a3 = g * band.a2;
+    band.m1 = k * (a * a - 1.0f);
+}
+
+void SootheFilterBank::packLanes()
+{
+    for (size_t b = 0; b < laneBands.size(); ++b)
+    {
+        auto& lane = laneBands[b];
+        lane.anyActive = false;
+
+        for (size_t ch = 0; ch < bands.size(); ++ch)
+        {
+            const auto& band = bands[ch][b];
+
+            lane.a1.set(ch, band.a1);
+            lane.a2.set(ch, band.a2);
+            lane.a3.set(ch, band.a3);
+            lane.m1.set(ch, band.active ? band.m1 : 0.0f);
+            lane.keepState.set(ch, band.active ? 1.0f : 0.0f);
+            lane.anyActive = lane.anyActive || band.active;
+        }
+
+        lane.ic1eq = lane.ic1eq * lane.keepState;
+        lane.ic2eq = lane.ic2eq * lane.keepState;
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+
+/**
+ * Dynamic-EQ engine for Soothe's Live quality
+ * One cascade of peaking filters per channel, placed on the deepest dips of
+ * that channel's attenuation curve. The filters are minimum-phase state-
+ * variable bells, so the audio path adds no latency of its own. Filter
+ * parameters glide to new targets over one hop, with coefficients
+ * recomputed every sub-block. A cascade is serial, so the channels are what
+ * runs in parallel: band b of every channel shares one SIMD register.
+ */
+class SootheFilterBank
+{
+public:
+    static constexpr int maxChannels = 2;
+    static constexpr int maxBands = 8;
+    static constexpr int subBlockSize = 32;
+
+    void prepare(double newSampleRate, int newHopSize);
+    void reset();
+
+    // Called once per hop per channel with its analyser's per-bin attenuation
+    // (linear gain). The glide starts with the next sub-block.
+    void setTargets(int channel, const float* attenuation, int fftSize);
+
+    // In place; right is nullptr for mono
+    void process(float* left, float* right, int numSamples);
+
+    int getNumActiveBands(int channel) const;
+
+private:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+    static constexpr int numLanes = static_cast<int>(Lanes::SIMDNumElements);
+    static_assert(numLanes >= maxChannels, "Each channel needs a lane");
+
+    struct BandParameters
+    {
+        float pitch = 0.0f;   // log2(Hz)
+        float gainDB = 0.0f;  // <= 0
+        float logQ = 0.0f;    // log2(Q)
+    };
+
+    // One channel's band: where it is, where it glides, and its coefficients
+    struct Band
+    {
+        BandParameters current, target, step;
+        int stepsLeft = 0;
+
+        float a1 = 1.0f, a2 = 0.0f, a3 = 0.0f, m1 = 0.0f;
+        bool active = false;
+    };
+
+    // Simper/Cytomic SVF bell, one lane per channel: stays well behaved while
+    // its coefficients move. A lane whose band is off has m1 = 0, and its
+    // state is dropped after each sub-block, as if it had been skipped.
+    struct LaneBand
+    {
+        Lanes a1, a2, a3, m1;
+        Lanes ic1eq, ic2eq;
+        Lanes keepState;  // 1 in active lanes, 0 elsewhere
+        bool anyActive = false;
+    };
+
+    struct Peak
+    {
+        float frequency = 0.0f;
+        float gainDB = 0.0f;
+        float q = 1.0f;
+    };
+
+    std::array<std::array<Band, maxBands>, maxChannels> bands;
+    std::array<LaneBand, maxBands> laneBands;
+
+    // The sub-block being filtered, one register's worth of samples per frame
+    alignas(Lanes::SIMDRegisterSize) std::array<float, subBlockSize * numLanes> frames{};
+
+    double sampleRate = 44100.0;
+    int stepsPerHop = 1;
+    int subBlockPosition = 0;
+
+    int findPeaks(const float* attenuation, int fftSize, std::array<Peak, maxBands>& peaks) const;
+    void assignPeaks(std::array<Band, maxBands>& channelBands, const std::array<Peak, maxBands>& peaks, int numPeaks);
+    void advanceBands();
+    void updateCoefficients(Band& band) const;
+    void packLanes();
+};
@@ -1,49 +1,222 @@
 #include "SootheModule.h"
+#include "TraceRecorder.h"
 #include <cmath>
 #include <algorithm>
+#include <limits>
 
 SootheModule::SootheModule()
 {
+    for (size_t ch = 0; ch < pooledFrames.size(); ++ch)
+    {
+        pooledFrames[ch].owner = this;
+        pooledFrames[ch].channel = static_cast<int>(ch);
+    }
+}
+
+SootheModule::~SootheModule()
+{
+    // The pool may still hold pointers to our frames
+    for (auto& frame : pooledFrames)
+        pool->release(frame);
+}
+
+SootheModule::FrameSettings SootheModule::FrameSettings::fromParameters(const Parameters& params)
+{
+    FrameSettings settings;
+    settings.analysis = SootheAnalyser::Settings::fromParameters(params);
+    settings.mix = params.getValue(ParamIDs::sootheMix) * 0.01f;
+    settings.delta = params.getBoolValue(ParamIDs::sootheDelta);
+    return settings;
 }
 
 void SootheModule::prepare(const juce::dsp::ProcessSpec& spec)
 {
     sampleRate = spec.sampleRate;
 
-    // Set FFT parameters based on quality (will be updated in process())
-    fftSize = 1024;  // Default to Normal
-    hopSize = 256;
-    currentQuality = Quality::Normal;
+    // Allocate for every quality at this rate, so switching quality on the
+    // audio thread only re-slices buffers
+    int capacity = 0;
+    maxLatencySamples = 0;
+
+    for (auto quality : {Quality::Eco, Quality::Normal, Quality::High, Quality::Live})
+    {
+        for (auto frameOverlap : {Overlap::Auto, Overlap::Half, Overlap::ThreeQuarters, Overlap::SevenEighths})
+        {
+            const auto size = getFrameSize(quality, frameOverlap, sampleRate);
+            capacity = std::max(capacity, size.fftSize);
+            maxLatencySamples = std::max(maxLatencySamples, size.fftSize + size.hopSize);
+
+            const int order = juce::roundToInt(std::log2(size.fftSize));
+            if (ffts[static_cast<size_t>(order)] == nullptr)
+                ffts[static_cast<size_t>(order)] = std::make_unique<juce::dsp::FFT>(order);
+        }
+    }
+
+    // Not processing now, so frames still in flight can be waited for
+    waitForPooledFrames();
+    reserveBuffers(capacity);
+
+    // Quality and overlap are updated from the parameters in process()
+    setQuality(currentQuality, overlap);
+
+    startBackgroundThreads();
+}
+
+bool SootheModule::needsBackgroundThreads() const
+{
+    if (workerWanted.load(std::memory_order_relaxed) && runningWorker.load(std::memory_order_relaxed) == nullptr)
+        return true;
+
+    return poolWanted.load(std::memory_order_relaxed) && !pool->isStarted();
+}
+
+void SootheModule::startBackgroundThreads()
+{
+    if (poolWanted.load())
+        pool->start();
+
+    if (!workerWanted.load() || worker != nullptr)
+        return;
+
+    worker = std::make_unique<SootheAnalysisWorker>();
+    worker->start();
+    runningWorker.store(worker.get(), std::memory_order_release);
+}
+
+void SootheModule::reset()
+{
+    resetChannels();
+}
+
+void SootheModule::resetChannels()
+{
+    for (size_t ch = 0; ch < channelState.size(); ++ch)
+    {
+        // A pool thread still owns this channel's frame: the reset happens
+        // at the deadline where it has finished, and its result is dropped
+        if (!pool->tryComplete(pooledFrames[ch]))
+        {
+            channelState[ch].resetPending = true;
+            continue;
+        }
+
+        channelState[ch].reset(getHopOffset(static_cast<int>(ch)));
+    }
+
+    liveFilters.reset();
+}
+
+int SootheModule::getHopOffset(int channel) const
+{
+    // Channels reach their hop boundaries half a hop apart, so with small host
+    // buffers their frames land in different callbacks. The offset only moves
+    // where frames are computed, not the latency.
+    return channel * hopSize / static_cast<int>(channelState.size());
+}
+
+SootheModule::Resolution SootheModule::getResolution(Quality quality)
+{
+    // The sizes each quality had at 44.1 kHz
+    switch (quality)
+    {
+        case Quality::Eco:    return {44100.0f / 512.0f, 128.0f / 44100.0f};
+        case Quality::Normal: return {44100.0f / 1024.0f, 256.0f / 44100.0f};
+        case Quality::High:   return {44100.0f / 2048.0f, 512.0f / 44100.0f};
+        case Quality::Live:   return {44100.0f / 1024.0f, 128.0f / 44100.0f};
+    }
+
+    return {44100.0f / 1024.0f, 256.0f / 44100.0f};
+}
+
+SootheModule::FrameSize SootheModule::getFrameSize(Quality quality, Overlap overlap, double rate)
+{
+    const auto resolution = getResolution(quality);
+
+    // Nearest power of two on a log scale, so 48 kHz keeps 44.1 kHz's sizes
+    auto nearestPowerOfTwo = [](double size) {
+        return 1 << juce::roundToInt(std::log2(std::max(1.0, size)));
+    };
+
+    FrameSize size;
+    size.fftSize = juce::jlimit(minFFTSize, maxFFTSize, nearestPowerOfTwo(rate / resolution.binHz));
+
+    // Live's hop is its filter update rate, so overlap does not apply
+    if (quality == Quality::Live)
+        overlap = Overlap::Auto;
 
-    // Create FFT
-    fft = std::make_unique<juce::dsp::FFT>(static_cast<int>(std::log2(fftSize)));
+    int hop = 0;
 
-    // Prepare channel states
+    switch (overlap)
+    {
+        case Overlap::Auto:          hop = std::min(size.fftSize / 4, nearestPowerOfTwo(rate * resolution.hopSeconds)); break;
+        case Overlap::Half:          hop = size.fftSize / 2; break;
+        case Overlap::ThreeQuarters: hop = size.fftSize / 4; break;
+        case Overlap::SevenEighths:  hop = size.fftSize / 8; break;
+    }
+
+    size.hopSize = std::max(minHopSize, hop);
+    return size;
+}
+
+void SootheModule::reserveBuffers(int capacity)
+{
+    const auto size = static_cast<size_t>(capacity);
+
+    for (auto& state : channelState)
+    {
+        state.inputFIFO.reserve(size);
+        state.outputFIFO.reserve(size);
+        state.dryHop.reserve(size / 2);
+        state.lateDryHop.reserve(size / 2);
+        state.frame.reserve(size);
+        state.fftData.reserve(size * 2);
+        state.ifftData.reserve(size * 2);
+        state.magnitudes.reserve(size / 2 + 1);
+        state.workerAttenuation.reserve(SootheAnalyser::maxBins);  // Swapped with worker results
+        state.overlapBuffer.reserve(size);
+        state.analyser.reserve(capacity);
+    }
+
+    analysisWindow.reserve(size);
+    synthesisWindow.reserve(size);
+}
+
+void SootheModule::resizeBuffers()
+{
+    // Within the capacity reserved in prepare(): never allocates. Callers
+    // have completed the pooled frames, which use these buffers.
     for (auto& state : channelState)
     {
         state.inputFIFO.resize(fftSize, 0.0f);
         state.outputFIFO.resize(fftSize, 0.0f);
+        state.dryHop.resize(hopSize, 0.0f);
+        state.lateDryHop.resize(hopSize, 0.0f);
+        state.frame.resize(fftSize, 0.0f);
         state.fftData.resize(fftSize * 2, 0.0f);
         state.ifftData.resize(fftSize * 2, 0.0f);
-        state.window.resize(fftSize);
         state.magnitudes.resize(fftSize / 2 + 1, 0.0f);
-        state.baseline.resize(fftSize / 2 + 1, 0.0f);
-        state.attenuation.resize(fftSize / 2 + 1, 1.0f);
-        state.resonanceScore.resize(fftSize / 2 + 1, 0.0f);
+        state.workerAttenuation.resize(fftSize / 2 + 1, 1.0f);
         state.overlapBuffer.resize(fftSize, 0.0f);
-
-        createWindow(state.window, fftSize);
+        state.analyser.prepare(fftSize, sampleRate, getResolution(currentQuality).binHz);
     }
 
-    latencySamples = fftSize;
+    liveFilters.prepare(sampleRate, hopSize);
 
-    reset();
+    analysisWindow.resize(fftSize);
+    synthesisWindow.resize(fftSize);
+    createWindows();
+    updateDisplayBins();
 }
 
-void SootheModule::reset()
+void SootheModule::updateLatency()
 {
-    for (auto& state : channelState)
-        state.reset();
+    // A frame's output starts playing one window after its first sample
+    // arrived; Spread and Worker finish each frame a hop later. Live delays
+    // the audio by a hop so filters line up with the frame that set them.
+    if (currentQuality == Quality::Live)
+        latencySamples = hopSize;
+    else
+        latencySamples = fftSize + (scheduling != Scheduling::Inline ? hopSize : 0);
 }
 
 void SootheModule::process(juce::dsp::AudioBlock<float>& block, const Parameters& params)
@@ -51,50 +224,51 @@ void SootheModule::process(juce::dsp::AudioBlock<float>& block, const Parameters
     if (params.getBoolValue(ParamIDs::sootheBypass))
         return;
 
+    processActive(block, params);
+}
+
+void SootheModule::updateSettings(const Parameters& params)
+{
     // Check if quality mode has changed and reinitialize if needed
     int quality = params.getIntValue(ParamIDs::sootheQuality);
-    Quality newQuality = (quality == 0) ? Quality::Eco : (quality == 1) ? Quality::Normal : Quality::High;
+    Quality newQuality = static_cast<Quality>(juce::jlimit(0, 3, quality));
 
-    if (newQuality != currentQuality)
-    {
-        currentQuality = newQuality;
+    const auto newOverlap = static_cast<Overlap>(params.getIntValue(ParamIDs::sootheOverlap));
+    const auto newScheduling = static_cast<Scheduling>(params.getIntValue(ParamIDs::sootheScheduling));
 
-        // Update FFT size based on quality
-        if (currentQuality == Quality::Eco)
-            fftSize = 512;
-        else if (currentQuality == Quality::Normal)
-            fftSize = 1024;
-        else
-            fftSize = 2048;
+    const bool qualityChanged = newQuality != currentQuality || newOverlap != overlap;
+
+    if (!qualityChanged && newScheduling == scheduling)
+        return;
 
-        hopSize = fftSize / 4;
+    // Pooled frames in flight still use the current buffers; a later block
+    // applies the change once they have finished
+    if (!tryCompletePooledFrames())
+        return;
 
-        // Recreate FFT and resize buffers
-        fft = std::make_unique<juce::dsp::FFT>(static_cast<int>(std::log2(fftSize)));
+    if (qualityChanged)
+        setQuality(newQuality, newOverlap);
 
-        for (auto& state : channelState)
-        {
-            state.inputFIFO.resize(fftSize, 0.0f);
-            state.outputFIFO.resize(fftSize, 0.0f);
-            state.fftData.resize(fftSize * 2, 0.0f);
-            state.ifftData.resize(fftSize * 2, 0.0f);
-            state.window.resize(fftSize);
-            state.magnitudes.resize(fftSize / 2 + 1, 0.0f);
-            state.baseline.resize(fftSize / 2 + 1, 0.0f);
-            state.attenuation.resize(fftSize / 2 + 1, 1.0f);
-            state.resonanceScore.resize(fftSize / 2 + 1, 0.0f);
-            state.overlapBuffer.resize(fftSize, 0.0f);
-
-            createWindow(state.window, fftSize);
-            state.fifoIndex = 0;
-            state.hopCounter = 0;
-        }
+    if (newScheduling != scheduling)
+        setScheduling(newScheduling);
+}
 
-        latencySamples = fftSize;
+void SootheModule::processActive(juce::dsp::AudioBlock<float>& block, const Parameters& params)
+{
+    updateSettings(params);
+    numDisplayChannels = std::min(2, static_cast<int>(block.getNumChannels()));
+
+    // Live runs its own pipeline; scheduling does not apply
+    if (currentQuality == Quality::Live)
+    {
+        processLive(block, params);
+        return;
     }
 
     const int numChannels = std::min(2, static_cast<int>(block.getNumChannels()));
     const int numSamples = static_cast<int>(block.getNumSamples());
+    const int writeOffset = fftSize - hopSize;
+    const bool spread = scheduling == Scheduling::Spread;
 
     for (int ch = 0; ch < numChannels; ++ch)
     {
@@ -103,39 +277,252 @@ void SootheModule::process(juce::dsp::AudioBlock<float>& block, const Parameters
 
         for (int i = 0; i < numSamples; ++i)
         {
-            // Store input in FIFO
-            state.inputFIFO[state.fifoIndex] = channelData[i];
+            // Newest hop fills the end of the input FIFO
+            state.inputFIFO[writeOffset + state.hopPosition] = channelData[i];
 
             // Output from FIFO (delay compensation)
-            channelData[i] = state.outputFIFO[state.fifoIndex];
+            channelData[i] = state.outputFIFO[state.hopPosition];
+
+            state.hopPosition++;
 
-            state.fifoIndex++;
+            if (spread && state.pendingStage != FrameStage::Idle)
+                runPendingStage(state, params);
 
             // Process when hop is reached
-            if (state.fifoIndex >= hopSize)
+            if (state.hopPosition >= hopSize)
             {
-                state.fifoIndex = 0;
-                state.hopCounter++;
-
-                if (state.hopCounter >= (fftSize / hopSize))
-                {
-                    state.hopCounter = 0;
-                    processFFTFrame(state, params);
-                }
+                state.hopPosition = 0;
+                finishHop(ch, params);
             }
         }
     }
 }
 
+void SootheModule::setQuality(Quality newQuality, Overlap newOverlap)
+{
+    currentQuality = newQuality;
+    overlap = newOverlap;
+
+    const auto size = getFrameSize(currentQuality, overlap, sampleRate);
+    fftSize = size.fftSize;
+    hopSize = size.hopSize;
+    fft = ffts[static_cast<size_t>(juce::roundToInt(std::log2(fftSize)))].get();
+
+    resizeBuffers();
+    resetChannels();
+    updateLatency();
+}
+
+void SootheModule::setScheduling(Scheduling newScheduling)
+{
+    scheduling = newScheduling;
+
+    // The threads themselves are started from the message thread
+    if (scheduling == Scheduling::Worker)
+        workerWanted.store(true);
+    else if (scheduling == Scheduling::SharedPool)
+        poolWanted.store(true);
+
+    // Frames in flight belong to the old pipeline
+    resetChannels();
+    updateLatency();
+}
+
+bool SootheModule::copyStateFrom(const SootheModule& other)
+{
+    // Pool threads may still be writing either instance's channel state
+    if (!tryCompletePooledFrames() || !other.tryCompletePooledFrames())
+        return false;
+
+    if (other.currentQuality != currentQuality || other.overlap != overlap)
+        setQuality(other.currentQuality, other.overlap);
+
+    if (other.scheduling != scheduling)
+        setScheduling(other.scheduling);
+
+    // Buffers are the same size, so this copies without allocating. The
+    // worker's smoothing state stays behind; its next job starts afresh.
+    channelState = other.channelState;
+
+    for (auto& state : channelState)
+        state.workerResetPending = true;
+
+    return true;
+}
+
+void SootheModule::finishHop(int channel, const Parameters& params)
+{
+    auto& state = channelState[static_cast<size_t>(channel)];
+
+    if (scheduling == Scheduling::Inline)
+    {
+        processFFTFrame(state, params);
+        return;
+    }
+
+    if (scheduling == Scheduling::Worker)
+    {
+        auto* activeWorker = runningWorker.load(std::memory_order_acquire);
+
+        // Last hop's frame goes out with the newest curve the worker has
+        // published (its own, unless the worker ran late)
+        if (state.pendingStage == FrameStage::Synthesise)
+        {
+            const auto settings = FrameSettings::fromParameters(params);
+
+            if (state.pendingAnalysedInline)
+            {
+                synthesiseFrame(state, settings, 0, state.analyser.getAttenuation().data(), state.analyser.isUnity());
+                publishDisplay(state, state.analyser.getAttenuation().data(), true);
+            }
+            else
+            {
+                if (activeWorker != nullptr)
+                    collectWorkerResults(*activeWorker);
+
+                synthesiseFrame(state, settings, 0, state.workerAttenuation.data(), state.workerUnity);
+                publishDisplay(state, state.workerAttenuation.data(), false);
+            }
+        }
+
+        captureFrame(state);
+        transformFrame(state);
+
+        // Until the message thread has started the worker, analyse here
+        state.pendingAnalysedInline = activeWorker == nullptr;
+
+        if (activeWorker != nullptr)
+            submitToWorker(*activeWorker, channel, params);
+        else
+            analyseFrame(state, SootheAnalyser::Settings::fromParameters(params));
+
+        state.pendingStage = FrameStage::Synthesise;
+        return;
+    }
+
+    // Deadline for last hop's pooled frame: if no pool thread has picked it
+    // up yet it runs here. One still running on a pool thread is not waited
+    // for; the channel plays dry until it has finished.
+    if (scheduling == Scheduling::SharedPool && state.pendingStage == FrameStage::Synthesise)
+    {
+        if (!pool->tryComplete(pooledFrames[static_cast<size_t>(channel)]))
+        {
+            skipLateFrame(state);
+            return;
+        }
+
+        // Reset while the frame ran: its result belongs to the old state
+        if (state.resetPending)
+        {
+            state.reset(getHopOffset(channel));
+            return;
+        }
+
+        if (state.skippedFrames == 0)
+            publishDisplay(state, state.analyser.getAttenuation().data(), true);
+    }
+
+    // The frame finished during this hop plays next
+    if (state.skippedFrames > 0)
+        resumeAfterLateFrame(state);
+    else
+        std::copy(state.outputFIFO.begin() + hopSize, state.outputFIFO.begin() + 2 * hopSize, state.outputFIFO.begin());
+
+    if (scheduling == Scheduling::SharedPool)
+    {
+        auto& frame = pooledFrames[static_cast<size_t>(channel)];
+
+        captureFrame(state);
+        frame.settings = FrameSettings::fromParameters(params);
+        state.pendingStage = FrameStage::Synthesise;
+
+        // Pool queues full: nothing else will run it in time
+        if (!pool->submit(frame))
+            processPooledFrame(frame);
+
+        return;
+    }
+
+    // Only the (cheap) capture happens at the boundary; the rest is spread
+    // over the next hop
+    captureFrame(state);
+    state.pendingStage = FrameStage::Transform;
+}
+
+void SootheModule::runPendingStage(ChannelState& state, const Parameters& params)
+{
+    // Stages run at 1/4, 2/4 and 3/4 of the hop; the last one writes the
+    // second half of the output FIFO before the boundary swaps it in
+    const int quarter = hopSize / 4;
+
+    switch (state.pendingStage)
+    {
+        case FrameStage::Transform:
+            if (state.hopPosition == quarter)
+            {
+                transformFrame(state);
+                state.pendingStage = FrameStage::Analyse;
+            }
+            break;
+
+        case FrameStage::Analyse:
+            if (state.hopPosition == 2 * quarter)
+            {
+                analyseFrame(state, SootheAnalyser::Settings::fromParameters(params));
+                publishDisplay(state, state.analyser.getAttenuation().data(), true);
+                state.pendingStage = FrameStage::Synthesise;
+            }
+            break;
+
+        case FrameStage::Synthesise:
+            if (state.hopPosition == 3 * quarter)
+            {
+                synthesiseFrame(state, FrameSettings::fromParameters(params), hopSize,
+                                state.analyser.getAttenuation().data(), state.analyser.isUnity());
+                state.pendingStage = FrameStage::Idle;
+            }
+            break;
+
+        case FrameStage::Idle:
+            break;
+    }
+}
+
 void SootheModule::processFFTFrame(ChannelState& state, const Parameters& params)
 {
-    // Copy input with window
+    MCC_TRACE_SCOPE("Soothe FFT frame");
+
+    const auto settings = FrameSettings::fromParameters(params);
+
+    captureFrame(state);
+    transformFrame(state);
+    analyseFrame(state, settings.analysis);
+    publishDisplay(state, state.analyser.getAttenuation().data(), true);
+    synthesiseFrame(state, settings, 0, state.analyser.getAttenuation().data(), state.analyser.isUnity());
+}
+
+void SootheModule::captureFrame(ChannelState& state)
+{
+    // Copy input with window; the transform works in place, so keep a copy
     for (int i = 0; i < fftSize; ++i)
     {
-        state.fftData[i] = state.inputFIFO[i] * state.window[i];
+        state.frame[i] = state.inputFIFO[i] * analysisWindow[i];
+        state.fftData[i] = state.frame[i];
         state.fftData[fftSize + i] = 0.0f;  // Zero imaginary part
     }
 
+    // Oldest hop is the one this frame completes: keep it for the dry mix
+    std::copy(state.inputFIFO.begin(), state.inputFIFO.begin() + hopSize, state.dryHop.begin());
+
+    // Shift input FIFO
+    std::copy(state.inputFIFO.begin() + hopSize, state.inputFIFO.end(), state.inputFIFO.begin());
+    std::fill(state.inputFIFO.end() - hopSize, state.inputFIFO.end(), 0.0f);
+}
+
+void SootheModule::transformFrame(ChannelState& state)
+{
+    MCC_TRACE_SCOPE("Soothe transform");
+
     // Forward FFT
     fft->performRealOnlyForwardTransform(state.fftData.data(), true);
 
@@ -146,42 +533,43 @@ void SootheModule::processFFTFrame(ChannelState& state, const Parameters& params
         const float imag = state.fftData[k * 2 + 1];
         state.magnitudes[k] = std::sqrt(real * real + imag * imag);
     }
+}
 
-    // Get parameters
-    const float amount = params.getValue(ParamIDs::sootheAmount) * 0.01f;
-    const float sensitivity = params.getValue(ParamIDs::sootheSensitivity) * 0.01f;
-    const float sharpness = params.getValue(ParamIDs::sootheSharpness) * 0.01f;
-    const float speed = params.getValue(ParamIDs::sootheSpeed) * 0.01f;
-    const float focusLow = params.getValue(ParamIDs::sootheFocusLow);
-    const float focusHigh = params.getValue(ParamIDs::sootheFocusHigh);
-    const float mix = params.getValue(ParamIDs::sootheMix) * 0.01f;
-    const bool deltaMode = params.getBoolValue(ParamIDs::sootheDelta);
+void SootheModule::analyseFrame(ChannelState& state, const SootheAnalyser::Settings& settings)
+{
+    MCC_TRACE_SCOPE("Soothe analysis");
+
+    state.analyser.analyse(state.magnitudes.data(), settings);
+}
 
-    // Compute baseline
-    const float smoothingWidth = 5.0f + sharpness * 20.0f;
-    computeBaseline(state, smoothingWidth);
+void SootheModule::synthesiseFrame(ChannelState& state, const FrameSettings& settings, int outputOffset,
+                                   const float* attenuation, bool unity)
+{
+    MCC_TRACE_SCOPE("Soothe synthesis");
 
-    // Compute resonance scores
-    computeResonanceScore(state, sensitivity, focusLow, focusHigh);
+    const float mix = settings.mix;
+    const bool deltaMode = settings.delta;
 
-    // Update attenuation
-    updateAttenuation(state, amount, speed, sharpness);
+    // Overlap-add with window
+    const float synthesisGain = 1.0f / windowGain;
 
-    // Apply attenuation to complex spectrum
-    for (int k = 0; k <= fftSize / 2; ++k)
+    if (unity && unityShortcut)
     {
-        state.fftData[k * 2] *= state.attenuation[k];
-        state.fftData[k * 2 + 1] *= state.attenuation[k];
+        // Nothing to attenuate: the inverse transform would only give back
+        // the windowed input, so overlap-add that and keep the state exact
+        for (int i = 0; i < fftSize; ++i)
+            state.overlapBuffer[i] += state.frame[i] * synthesisWindow[i] * synthesisGain;
     }
+    else
+    {
+        applyAttenuation(state, attenuation);
 
-    // Inverse FFT
-    std::copy(state.fftData.begin(), state.fftData.end(), state.ifftData.begin());
-    fft->performRealOnlyInverseTransform(state.ifftData.data());
+        // Inverse FFT
+        std::copy(state.fftData.begin(), state.fftData.end(), state.ifftData.begin());
+        fft->performRealOnlyInverseTransform(state.ifftData.data());
 
-    // Overlap-add with window
-    for (int i = 0; i < fftSize; ++i)
-    {
-        state.overlapBuffer[i] += state.ifftData[i] * state.window[i] / static_cast<float>(fftSize / hopSize);
+        for (int i = 0; i < fftSize; ++i)
+            state.overlapBuffer[i] += state.ifftData[i] * synthesisWindow[i] * synthesisGain;
     }
 
     // Copy to output FIFO
@@ -190,135 +578,343 @@ void SootheModule::processFFTFrame(ChannelState& state, const Parameters& params
         float processed = state.overlapBuffer[i];
 
         // Mix
-        float dry = state.inputFIFO[i];
+        float dry = state.dryHop[i];
         float output = dry * (1.0f - mix) + processed * mix;
 
         // Delta mode
         if (deltaMode)
             output = dry - processed;
 
-        state.outputFIFO[i] = output;
+        state.outputFIFO[outputOffset + i] = output;
     }
 
     // Shift overlap buffer
     std::copy(state.overlapBuffer.begin() + hopSize, state.overlapBuffer.end(), state.overlapBuffer.begin());
     std::fill(state.overlapBuffer.end() - hopSize, state.overlapBuffer.end(), 0.0f);
+}
 
-    // Shift input FIFO
-    std::copy(state.inputFIFO.begin() + hopSize, state.inputFIFO.end(), state.inputFIFO.begin());
-    std::fill(state.inputFIFO.end() - hopSize, state.inputFIFO.end(), 0.0f);
+void SootheModule::applyAttenuation(ChannelState& state, const float* attenuation)
+{
+    // Apply attenuation to complex spectrum
+    for (int k = 0; k <= fftSize / 2; ++k)
+    {
+        state.fftData[k * 2] *= attenuation[k];
+        state.fftData[k * 2 + 1] *= attenuation[k];
+    }
 }
 
-void SootheModule::computeBaseline(ChannelState& state, float smoothingWidth)
+void SootheModule::processLive(juce::dsp::AudioBlock<float>& block, const Parameters& params)
 {
-    // Simple moving average baseline
-    const int width = static_cast<int>(smoothingWidth);
+    const int numChannels = std::min(2, static_cast<int>(block.getNumChannels()));
+    const int numSamples = static_cast<int>(block.getNumSamples());
+    const int writeOffset = fftSize - hopSize;
 
-    for (int k = 0; k <= fftSize / 2; ++k)
+    const float mix = params.getValue(ParamIDs::sootheMix) * 0.01f;
+    const bool deltaMode = params.getBoolValue(ParamIDs::sootheDelta);
+
+    std::array<float*, 2> segments{};
+    std::array<const float*, 2> delayed{};
+    int start = 0;
+
+    // Segments never cross either channel's hop boundary, where that
+    // channel's filter targets change
+    while (start < numSamples)
     {
-        float sum = 0.0f;
-        int count = 0;
+        int count = numSamples - start;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            count = std::min(count, hopSize - channelState[static_cast<size_t>(ch)].hopPosition);
 
-        for (int n = std::max(0, k - width); n <= std::min(fftSize / 2, k + width); ++n)
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            sum += state.magnitudes[n];
-            count++;
+            auto& state = channelState[static_cast<size_t>(ch)];
+            float* segment = block.getChannelPointer(static_cast<size_t>(ch)) + start;
+
+            // Newest samples feed the analysis; the previous hop, still in
+            // the FIFO just before them, is what plays now
+            float* newest = state.inputFIFO.data() + writeOffset + state.hopPosition;
+            const float* previous = newest - hopSize;
+
+            std::copy(segment, segment + count, newest);
+            std::copy(previous, previous + count, segment);
+
+            segments[static_cast<size_t>(ch)] = segment;
+            delayed[static_cast<size_t>(ch)] = previous;
         }
 
-        state.baseline[k] = (count > 0) ? sum / static_cast<float>(count) : state.magnitudes[k];
+        liveFilters.process(segments[0], segments[1], count);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto& state = channelState[static_cast<size_t>(ch)];
+            float* segment = segments[static_cast<size_t>(ch)];
+            const float* dry = delayed[static_cast<size_t>(ch)];
+
+            if (deltaMode)
+            {
+                for (int i = 0; i < count; ++i)
+                    segment[i] = dry[i] - segment[i];
+            }
+            else if (mix < 1.0f)
+            {
+                for (int i = 0; i < count; ++i)
+                    segment[i] = dry[i] * (1.0f - mix) + segment[i] * mix;
+            }
+
+            state.hopPosition += count;
+
+            if (state.hopPosition == hopSize)
+            {
+                state.hopPosition = 0;
+                processLiveFrame(ch, params);
+            }
+        }
+
+        start += count;
     }
 }
 
-void SootheModule::computeResonanceScore(ChannelState& state, float sensitivity,
-                                        float focusLow, float focusHigh)
+void SootheModule::processLiveFrame(int channel, const Parameters& params)
 {
-    const int binLow = freqToFFTBin(focusLow);
-    const int binHigh = freqToFFTBin(focusHigh);
+    MCC_TRACE_SCOPE("Soothe live frame");
 
-    for (int k = 0; k <= fftSize / 2; ++k)
+    auto& state = channelState[static_cast<size_t>(channel)];
+
+    captureFrame(state);
+    transformFrame(state);
+    analyseFrame(state, SootheAnalyser::Settings::fromParameters(params));
+    liveFilters.setTargets(channel, state.analyser.getAttenuation().data(), fftSize);
+    publishDisplay(state, state.analyser.getAttenuation().data(), true);
+}
+
+void SootheModule::submitToWorker(SootheAnalysisWorker& activeWorker, int channel, const Parameters& params)
+{
+    auto& state = channelState[static_cast<size_t>(channel)];
+    auto* job = activeWorker.beginJob();
+
+    // Worker behind: the frame just keeps the previous curve for one more hop
+    if (job == nullptr)
+        return;
+
+    job->channel = channel;
+    job->fftSize = fftSize;
+    job->sampleRate = sampleRate;
+    job->targetBinHz = getResolution(currentQuality).binHz;
+    job->reset = state.workerResetPending;
+    job->settings = SootheAnalyser::Settings::fromParameters(params);
+
+    // The display still reads this frame's magnitudes, so they are copied
+    // (only the bins in use; the slot has room for the largest FFT, so the
+    // copy never allocates)
+    job->magnitudes.assign(state.magnitudes.begin(), state.magnitudes.end());
+
+    activeWorker.submit(*job);
+    state.workerResetPending = false;
+}
+
+void SootheModule::collectWorkerResults(SootheAnalysisWorker& activeWorker)
+{
+    while (auto* result = activeWorker.fetch())
     {
-        // Outside focus range
-        if (k < binLow || k > binHigh)
+        // Results computed before a quality change no longer fit
+        if (result->fftSize == fftSize)
         {
-            state.resonanceScore[k] = 0.0f;
-            continue;
+            // Both vectors reserve maxBins, so the swap hands the old curve's
+            // storage back for the worker's next copy; neither side allocates
+            auto& state = channelState[static_cast<size_t>(result->channel)];
+            state.workerAttenuation.swap(result->attenuation);
+            state.workerUnity = result->unity;
         }
 
-        // Ratio of magnitude to baseline
-        const float ratio = state.magnitudes[k] / (state.baseline[k] + 1e-10f);
+        activeWorker.recycle(*result);
+    }
+}
 
-        // Resonance score
-        float score = std::max(0.0f, ratio - 1.0f);
-        score = std::pow(score, 1.5f);  // Selectivity
+void SootheModule::PooledFrame::process()
+{
+    owner->processPooledFrame(*this);
+}
 
-        state.resonanceScore[k] = score * sensitivity;
-    }
+void SootheModule::processPooledFrame(PooledFrame& frame)
+{
+    MCC_TRACE_SCOPE("Soothe pooled frame");
+
+    // Pool thread (or the audio thread, as the fallback). The audio thread
+    // meanwhile only touches the input FIFO and the output FIFO's first hop.
+    auto& state = channelState[static_cast<size_t>(frame.channel)];
+
+    if (pooledFrameHook)
+        pooledFrameHook();
+
+    transformFrame(state);
+    analyseFrame(state, frame.settings.analysis);
+    synthesiseFrame(state, frame.settings, hopSize, state.analyser.getAttenuation().data(), state.analyser.isUnity());
 }
 
-void SootheModule::updateAttenuation(ChannelState& state, float amount,
-                                    float speed, float sharpness)
+bool SootheModule::tryCompletePooledFrames() const
 {
-    const float maxAttnDB = -12.0f * amount;
-    const float attackCoeff = 0.1f + speed * 0.4f;
-    const float releaseCoeff = 0.01f + speed * 0.09f;
+    bool allComplete = true;
 
-    for (int k = 0; k <= fftSize / 2; ++k)
-    {
-        // Target attenuation in dB
-        const float targetAttnDB = -state.resonanceScore[k] * 12.0f * amount;
-        const float clampedAttnDB = std::max(targetAttnDB, maxAttnDB);
-        const float targetAttn = juce::Decibels::decibelsToGain(clampedAttnDB);
+    for (auto& frame : pooledFrames)
+        allComplete = pool->tryComplete(frame) && allComplete;
 
-        // Smooth attenuation over time
-        const float coeff = (targetAttn < state.attenuation[k]) ? attackCoeff : releaseCoeff;
-        state.attenuation[k] += (targetAttn - state.attenuation[k]) * coeff;
+    return allComplete;
+}
 
-        // Clamp
-        state.attenuation[k] = std::clamp(state.attenuation[k], 0.1f, 1.0f);
-    }
+void SootheModule::waitForPooledFrames() const
+{
+    for (auto& frame : pooledFrames)
+        pool->complete(frame);
+}
 
-    // Frequency smoothing based on sharpness
-    const int smoothWidth = static_cast<int>(1.0f + (1.0f - sharpness) * 5.0f);
-    std::vector<float> smoothed = state.attenuation;
-    smoothSpectrum(state.attenuation, smoothed, smoothWidth);
-    state.attenuation = smoothed;
+void SootheModule::skipLateFrame(ChannelState& state)
+{
+    // The pool thread still reads the frame, its dry hop and the overlap
+    // buffer, and writes the output FIFO's second hop. The audio thread only
+    // touches the input FIFO and the hop it plays next.
+    const auto& dry = state.skippedFrames == 0 ? state.dryHop : state.lateDryHop;
+    std::copy(dry.begin(), dry.begin() + hopSize, state.outputFIFO.begin());
+
+    // No frame is captured this hop; keep the hop it would have completed,
+    // which plays (dry) at the next boundary
+    std::copy(state.inputFIFO.begin(), state.inputFIFO.begin() + hopSize, state.lateDryHop.begin());
+    std::copy(state.inputFIFO.begin() + hopSize, state.inputFIFO.end(), state.inputFIFO.begin());
+    std::fill(state.inputFIFO.end() - hopSize, state.inputFIFO.end(), 0.0f);
+
+    ++state.skippedFrames;
 }
 
-void SootheModule::applyAttenuation(ChannelState& state)
+void SootheModule::resumeAfterLateFrame(ChannelState& state)
 {
-    // Already applied in processFFTFrame
+    // The late frame's output was due hops ago; play the last skipped
+    // frame's hop dry instead
+    std::copy(state.lateDryHop.begin(), state.lateDryHop.begin() + hopSize, state.outputFIFO.begin());
+
+    // Skipped frames added nothing to the overlap; move it on to line up
+    // with the frame captured now. The next few hops miss their
+    // contributions, which is the (audible, but short) cost of being late.
+    const int shift = std::min(fftSize, state.skippedFrames * hopSize);
+    std::copy(state.overlapBuffer.begin() + shift, state.overlapBuffer.end(), state.overlapBuffer.begin());
+    std::fill(state.overlapBuffer.end() - shift, state.overlapBuffer.end(), 0.0f);
+
+    state.skippedFrames = 0;
 }
 
-void SootheModule::createWindow(std::vector<float>& window, int size)
+void SootheModule::updateDisplayBins()
 {
-    // Hann window
-    for (int i = 0; i < size; ++i)
+    // Display point edges on a log scale, as FFT bins. Low points share bins;
+    // every point covers at least one.
+    const int lastBin = fftSize / 2;
+
+    for (int p = 0; p <= SootheDisplayFrame::numPoints; ++p)
     {
-        window[i] = 0.5f * (1.0f - std::cos(2.0f * juce::MathConstants<float>::pi * static_cast<float>(i) / static_cast<float>(size - 1)));
+        const float frequency = SootheDisplayFrame::getFrequency(static_cast<float>(p) / SootheDisplayFrame::numPoints);
+        displayBins[static_cast<size_t>(p)] = juce::jlimit(0, lastBin, juce::roundToInt(frequency * fftSize / sampleRate));
     }
+
+    displayFramePending = false;
 }
 
-void SootheModule::smoothSpectrum(const std::vector<float>& input,
-                                 std::vector<float>& output, int width)
+void SootheModule::setDisplay(SootheDisplay* newDisplay)
 {
-    const int size = static_cast<int>(input.size());
+    if (newDisplay == display)
+        return;
+
+    // A half-merged frame belongs to the previous display's write buffer
+    display = newDisplay;
+    displayFramePending = false;
+}
+
+void SootheModule::publishDisplay(const ChannelState& state, const float* attenuation, bool hasBaseline)
+{
+    if (display == nullptr || !display->isEnabled())
+        return;
 
-    for (int k = 0; k < size; ++k)
+    // The first channel's frame starts a display frame; later channels merge
+    // into it, and the last one publishes
+    const auto channel = static_cast<int>(&state - channelState.data());
+    const bool merge = channel > 0;
+
+    if (merge && !displayFramePending)
+        return;
+
+    auto& frame = display->getFrames().getWriteBuffer();
+    const int lastBin = fftSize / 2;
+
+    for (size_t p = 0; p < static_cast<size_t>(SootheDisplayFrame::numPoints); ++p)
     {
-        float sum = 0.0f;
-        int count = 0;
+        const int first = displayBins[p];
+        const int end = std::min(lastBin + 1, std::max(first + 1, displayBins[p + 1]));
+
+        float magnitude = 0.0f;
+        float gain = 1.0f;
 
-        for (int n = std::max(0, k - width); n <= std::min(size - 1, k + width); ++n)
+        for (int k = first; k < end; ++k)
         {
-            sum += input[n];
-            count++;
+            magnitude = std::max(magnitude, state.magnitudes[k]);
+            gain = std::min(gain, attenuation[k]);
         }
 
-        output[k] = (count > 0) ? sum / static_cast<float>(count) : input[k];
+        magnitude *= displayScale;
+        const float baseline = hasBaseline ? state.analyser.getBaseline((first + end - 1) / 2) * displayScale : 0.0f;
+
+        frame.magnitude[p] = merge ? std::max(frame.magnitude[p], magnitude) : magnitude;
+        frame.baseline[p] = merge ? std::max(frame.baseline[p], baseline) : baseline;
+        frame.attenuation[p] = merge ? std::min(frame.attenuation[p], gain) : gain;
+    }
+
+    frame.hasBaseline = merge ? frame.hasBaseline && hasBaseline : hasBaseline;
+
+    if (channel == numDisplayChannels - 1)
+    {
+        display->getFrames().publish();
+        displayFramePending = false;
+    }
+    else
+    {
+        displayFramePending = true;
     }
 }
 
-int SootheModule::freqToFFTBin(float freq) const
+void SootheModule::createWindows()
 {
-    return static_cast<int>((freq / static_cast<float>(sampleRate)) * static_cast<float>(fftSize));
+    // Periodic Hann pairs: Hann x Hann sums to a constant at hops of size/4 and
+    // below, sqrt-Hann x sqrt-Hann (= Hann) at size/2
+    const bool sqrtHann = hopSize > fftSize / 4;
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        const double hann = 0.5 * (1.0 - std::cos(juce::MathConstants<double>::twoPi * i / fftSize));
+        analysisWindow[i] = static_cast<float>(sqrtHann ? std::sqrt(hann) : hann);
+        synthesisWindow[i] = analysisWindow[i];
+    }
+
+    // Overlap-add gain, summed from the float windows actually applied
+    double sum = 0.0;
+    double minSum = std::numeric_limits<double>::max();
+    double maxSum = 0.0;
+
+    for (int i = 0; i < hopSize; ++i)
+    {
+        double phaseSum = 0.0;
+        for (int j = i; j < fftSize; j += hopSize)
+            phaseSum += static_cast<double>(analysisWindow[j]) * synthesisWindow[j];
+
+        sum += phaseSum;
+        minSum = std::min(minSum, phaseSum);
+        maxSum = std::max(maxSum, phaseSum);
+    }
+
+    // Constant overlap-add: every phase of the hop gets the same gain
+    jassert(maxSum - minSum < 1.0e-5 * maxSum);
+    juce::ignoreUnused(minSum, maxSum);
+
+    windowGain = static_cast<float>(sum / hopSize);
+
+    // A sine of amplitude A peaks at A * sum(window) / 2 in its bin
+    double windowSum = 0.0;
+    for (int i = 0; i < fftSize; ++i)
+        windowSum += analysisWindow[i];
+
+    displayScale = static_cast<float>(2.0 / windowSum);
 }
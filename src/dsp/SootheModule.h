@@ -3,84 +3,292 @@
 #include <juce_dsp/juce_dsp.h>
 #include <juce_audio_basics/juce_audio_basics.h>
 #include "Smoothing.h"
+#include "SootheAnalyser.h"
+#include "SootheAnalysisWorker.h"
+#include "SootheDisplay.h"
+#include "SootheFilterBank.h"
+#include "SpectralWorkerPool.h"
 #include "../Parameters.h"
+#include <atomic>
 #include <vector>
 #include <complex>
+#include <functional>
 
 /**
  * FFT-based adaptive resonance control
- * Detects and attenuates harsh resonances
+ * Detects and attenuates harsh resonances. Eco/Normal/High apply the
+ * attenuation in the spectrum (overlap-add, one window of latency); Live
+ * steers a bank of minimum-phase peaking filters instead (one hop).
  */
 class SootheModule
 {
 public:
     SootheModule();
+    ~SootheModule();
 
     void prepare(const juce::dsp::ProcessSpec& spec);
     void reset();
     void process(juce::dsp::AudioBlock<float>& block, const Parameters& params);
 
+    // Processes regardless of the bypass parameter (bypass handled by the router)
+    void processActive(juce::dsp::AudioBlock<float>& block, const Parameters& params);
+
+    // Applies quality, overlap and scheduling changes. processActive() does
+    // this itself; call it while bypassed so the latency stays current.
+    void updateSettings(const Parameters& params);
+
+    // Takes over another instance's FIFOs and spectral state. Returns false,
+    // copying nothing, while either instance has a SharedPool frame in
+    // flight; try again on a later block.
+    bool copyStateFrom(const SootheModule& other);
+
     int getLatencySamples() const { return latencySamples; }
+    int getTailSamples() const { return latencySamples + fftSize; }
+    int getMaxLatencySamples() const { return maxLatencySamples; }
+
+    // Message thread. Worker and SharedPool scheduling need threads that are
+    // only started once selected; until they run, those frames are processed
+    // on the audio thread. prepare() starts them if they are already wanted.
+    bool needsBackgroundThreads() const;
+    void startBackgroundThreads();
+
+    // Where to publish curves for the editor (nullptr: nowhere). Audio
+    // thread; a display must have one writer, so hand it over rather than share.
+    void setDisplay(SootheDisplay* newDisplay);
+
+    // Frames with a unity curve skip the inverse FFT. Tests turn this off
+    // (before processing) to run every frame through the full synthesis.
+    void setUnityShortcut(bool enabled) { unityShortcut = enabled; }
+
+    // Tests: called at the start of every SharedPool frame, on whichever
+    // thread runs it, so a test can hold one in flight. Set before processing.
+    void setPooledFrameHook(std::function<void()> hook) { pooledFrameHook = std::move(hook); }
 
     enum Quality
     {
         Eco = 0,
         Normal,
-        High
+        High,
+        Live
+    };
+
+    // Qualities are a target frequency resolution and hop duration; the FFT
+    // and hop sizes are the powers of two nearest them at the sample rate
+    struct Resolution
+    {
+        float binHz;
+        float hopSeconds;
+    };
+
+    struct FrameSize
+    {
+        int fftSize;
+        int hopSize;
+    };
+
+    // Overlap between successive frames (not Live). Auto keeps the quality's
+    // own hop. 50% pairs sqrt-Hann analysis and synthesis windows; 75% and
+    // 87.5% use Hann for both.
+    enum class Overlap
+    {
+        Auto = 0,
+        Half,
+        ThreeQuarters,
+        SevenEighths
+    };
+
+    static Resolution getResolution(Quality quality);
+    static FrameSize getFrameSize(Quality quality, Overlap overlap, double sampleRate);
+
+    // Where a frame's work happens. Inline runs the whole frame at the hop
+    // boundary; Spread splits it over the following hop; Worker analyses on
+    // a separate thread; SharedPool hands whole frames to a pool shared by
+    // every instance in the process. All but Inline add one hop of latency.
+    enum class Scheduling
+    {
+        Inline = 0,
+        Spread,
+        Worker,
+        SharedPool
     };
 
 private:
+    // Work left on the frame captured at the last hop boundary (Spread, Worker)
+    enum class FrameStage
+    {
+        Idle,
+        Transform,
+        Analyse,
+        Synthesise
+    };
+
+    // Parameters a frame is processed with, read when it is captured
+    struct FrameSettings
+    {
+        SootheAnalyser::Settings analysis;
+        float mix = 1.0f;  // 0-1
+        bool delta = false;
+
+        static FrameSettings fromParameters(const Parameters& params);
+    };
+
     struct ChannelState
     {
-        // FFT buffers
+        // FFT buffers: inputFIFO holds the last fftSize input samples, the
+        // newest hop at the end; outputFIFO's first hop is being played,
+        // its second receives the frame finishing during the hop (Spread)
         std::vector<float> inputFIFO;
         std::vector<float> outputFIFO;
+        std::vector<float> dryHop;
+        std::vector<float> lateDryHop;  // Oldest input hop of a frame skipped for lateness
+        std::vector<float> frame;  // Windowed input of the last captured frame
         std::vector<float> fftData;
-        std::vector<float> window;
         std::vector<float> ifftData;
 
         // Spectral processing
         std::vector<float> magnitudes;
-        std::vector<float> baseline;
-        std::vector<float> attenuation;
-        std::vector<float> resonanceScore;
+        SootheAnalyser analyser;
+
+        // Latest curve published by the analysis worker
+        std::vector<float> workerAttenuation;
+        bool workerUnity = true;
+        bool workerResetPending = true;
+        bool pendingAnalysedInline = false;  // No worker yet: the analyser has the curve
 
         // Overlap-add
         std::vector<float> overlapBuffer;
 
-        int fifoIndex = 0;
-        int hopCounter = 0;
+        int hopPosition = 0;
+        int skippedFrames = 0;  // SharedPool: frames not captured while one ran late
+        bool resetPending = false;  // SharedPool: reset once the running frame is done
+        FrameStage pendingStage = FrameStage::Idle;
 
-        void reset()
+        void reset(int hopOffset)
         {
             std::fill(inputFIFO.begin(), inputFIFO.end(), 0.0f);
             std::fill(outputFIFO.begin(), outputFIFO.end(), 0.0f);
+            std::fill(dryHop.begin(), dryHop.end(), 0.0f);
+            std::fill(lateDryHop.begin(), lateDryHop.end(), 0.0f);
             std::fill(fftData.begin(), fftData.end(), 0.0f);
             std::fill(overlapBuffer.begin(), overlapBuffer.end(), 0.0f);
-            std::fill(attenuation.begin(), attenuation.end(), 1.0f);
-            fifoIndex = 0;
-            hopCounter = 0;
+            std::fill(frame.begin(), frame.end(), 0.0f);
+            std::fill(workerAttenuation.begin(), workerAttenuation.end(), 1.0f);
+            workerUnity = true;
+            analyser.reset();
+            workerResetPending = true;
+            pendingAnalysedInline = false;
+            hopPosition = hopOffset;
+            skippedFrames = 0;
+            resetPending = false;
+            pendingStage = FrameStage::Idle;
         }
     };
 
-    std::unique_ptr<juce::dsp::FFT> fft;
+    static constexpr int maxFFTSize = SootheAnalyser::maxFFTSize;  // High at 192 kHz
+    static constexpr int minFFTSize = 256;
+    static constexpr int minHopSize = 32;  // Keeps Live's sub-blocks whole
+
+    // One transform per size any quality uses; fft points at the current one
+    std::array<std::unique_ptr<juce::dsp::FFT>, 14> ffts;
+    juce::dsp::FFT* fft = nullptr;
     std::array<ChannelState, 2> channelState;
 
+    // Live quality: filters applied to the input, one hop behind it. Both
+    // channels' cascades run together, so Live processes them in lockstep.
+    SootheFilterBank liveFilters;
+
+    // Created and started on the message thread once Worker scheduling is
+    // selected; the audio thread sees it through runningWorker
+    std::unique_ptr<SootheAnalysisWorker> worker;
+    std::atomic<SootheAnalysisWorker*> runningWorker{nullptr};
+    std::atomic<bool> workerWanted{false};
+
+    // One frame per channel in flight on the shared pool (SharedPool)
+    class PooledFrame : public SpectralWorkerPool::Job
+    {
+    public:
+        SootheModule* owner = nullptr;
+        int channel = 0;
+        FrameSettings settings;
+
+        void process() override;
+    };
+
+    // The pool's threads start when SharedPool is first selected by any
+    // instance; before that, submit() refuses and frames run inline
+    juce::SharedResourcePointer<SpectralWorkerPool> pool;
+    mutable std::array<PooledFrame, 2> pooledFrames;
+    std::atomic<bool> poolWanted{false};
+    std::function<void()> pooledFrameHook;
+
+    // Analysis and synthesis windows, and the overlap-add gain they produce
+    std::vector<float> analysisWindow;
+    std::vector<float> synthesisWindow;
+    float windowGain = 1.0f;
+    bool unityShortcut = true;
+
+    // Editor display: FFT bins covered by each display point, and the scale
+    // that makes a full-scale sine read 1. Channels are merged, then published.
+    SootheDisplay* display = nullptr;
+    std::array<int, SootheDisplayFrame::numPoints + 1> displayBins{};
+    float displayScale = 1.0f;
+    int numDisplayChannels = 2;
+    bool displayFramePending = false;
+
     double sampleRate = 44100.0;
     int fftSize = 2048;
     int hopSize = 512;
     int latencySamples = 0;
+    int maxLatencySamples = maxFFTSize + maxFFTSize / 4;
     Quality currentQuality = Quality::Normal;
+    Overlap overlap = Overlap::Auto;
+    Scheduling scheduling = Scheduling::Inline;
 
     // Processing
+    void setQuality(Quality newQuality, Overlap newOverlap);
+    void setScheduling(Scheduling newScheduling);
+    void reserveBuffers(int capacity);
+    void resizeBuffers();
+    void resetChannels();
+    void updateLatency();
+
+    // A frame runs capture -> transform -> analyse -> synthesise.
+    // processFFTFrame() runs the whole frame; Spread runs one stage at a time.
     void processFFTFrame(ChannelState& state, const Parameters& params);
-    void computeBaseline(ChannelState& state, float smoothingWidth);
-    void computeResonanceScore(ChannelState& state, float sensitivity, float focusLow, float focusHigh);
-    void updateAttenuation(ChannelState& state, float amount, float speed, float sharpness);
-    void applyAttenuation(ChannelState& state);
+    void finishHop(int channel, const Parameters& params);
+    void runPendingStage(ChannelState& state, const Parameters& params);
+    void captureFrame(ChannelState& state);
+    void transformFrame(ChannelState& state);
+    void analyseFrame(ChannelState& state, const SootheAnalyser::Settings& settings);
+    void synthesiseFrame(ChannelState& state, const FrameSettings& settings, int outputOffset,
+                         const float* attenuation, bool unity);
+    void applyAttenuation(ChannelState& state, const float* attenuation);
+
+    // Live quality: analysis only; the filter bank does the processing
+    void processLive(juce::dsp::AudioBlock<float>& block, const Parameters& params);
+    void processLiveFrame(int channel, const Parameters& params);
+
+    // Worker scheduling
+    void submitToWorker(SootheAnalysisWorker& activeWorker, int channel, const Parameters& params);
+    void collectWorkerResults(SootheAnalysisWorker& activeWorker);
+
+    // SharedPool scheduling. Frames must be complete before the channel
+    // buffers are resized, reset or copied. The audio thread never waits for
+    // one: a frame still running at its deadline plays its hop dry and pauses
+    // capture; a reset of its channel waits for it to finish and drops its
+    // result; quality, scheduling and state copies are retried next block.
+    // Only prepare() (message thread) blocks until frames finish.
+    void processPooledFrame(PooledFrame& frame);
+    bool tryCompletePooledFrames() const;
+    void waitForPooledFrames() const;
+    void skipLateFrame(ChannelState& state);
+    void resumeAfterLateFrame(ChannelState& state);
+
+    // Editor display
+    void updateDisplayBins();
+    void publishDisplay(const ChannelState& state, const float* attenuation, bool hasBaseline);
 
     // Helpers
-    void createWindow(std::vector<float>& window, int size);
-    void smoothSpectrum(const std::vector<float>& input, std::vector<float>& output, int width);
-    int freqToFFTBin(float freq) const;
+    void createWindows();
+    int getHopOffset(int channel) const;
 };
@@ -0,0 +1,246 @@
+#include "SpectralWorkerPool.h"
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    constexpr int queueCapacity = 1024;
+}
+
+/** One pool thread: drains its own queue first, then steals */
+class SpectralWorkerPool::Worker : public juce::Thread
+{
+public:
+    Worker(SpectralWorkerPool& p, size_t i)
+        : juce::Thread("Spectral worker " + juce::String(static_cast<int>(i))), pool(p), index(i)
+    {
+    }
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            // Each submission adds a permit, so a burst wakes several
+            // workers; permits left over just cost an empty pass
+            if (auto* job = pool.findWork(index))
+            {
+                pool.runFromQueue(*job);
+                continue;
+            }
+
+            pool.workAvailable.try_acquire_for(std::chrono::milliseconds(100));
+        }
+    }
+
+private:
+    SpectralWorkerPool& pool;
+    size_t index;
+};
+
+//==============================================================================
+SpectralWorkerPool::SpectralWorkerPool()
+{
+    // Leave a core for the host's own audio thread
+    const int numWorkers = juce::jmax(1, juce::SystemStats::getNumCpus() - 1);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        queues.push_back(std::make_unique<Queue>(queueCapacity));
+        workers.push_back(std::make_unique<Worker>(*this, static_cast<size_t>(i)));
+    }
+}
+
+SpectralWorkerPool::~SpectralWorkerPool()
+{
+    for (auto& worker : workers)
+        worker->signalThreadShouldExit();
+
+    workAvailable.release(static_cast<std::ptrdiff_t>(workers.size()));
+
+    for (auto& worker : workers)
+        worker->stopThread(1000);
+}
+
+void SpectralWorkerPool::start()
+{
+    const juce::ScopedLock sl(startLock);
+
+    if (started.load())
+        return;
+
+    for (auto& worker : workers)
+        if (!worker->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(7)))
+            worker->startThread(juce::Thread::Priority::high);
+
+    started.store(true);
+}
+
+bool SpectralWorkerPool::submit(Job& job)
+{
+    if (!started.load(std::memory_order_acquire))
+        return false;
+
+    // Release: a worker may reach this job through an older queue entry, so
+    // the state itself has to publish the caller's writes
+    job.state.store(Job::Queued, std::memory_order_release);
+    job.queueEntries.fetch_add(1, std::memory_order_relaxed);
+
+    const auto index = static_cast<size_t>(nextQueue.fetch_add(1, std::memory_order_relaxed)) % queues.size();
+
+    if (!queues[index]->push(&job))
+    {
+        job.queueEntries.fetch_sub(1, std::memory_order_relaxed);
+        job.state.store(Job::Idle, std::memory_order_relaxed);
+        return false;
+    }
+
+    workAvailable.release();
+    return true;
+}
+
+bool SpectralWorkerPool::runIfNotStarted(Job& job)
+{
+    int expected = Job::Queued;
+
+    // Not started yet: take it back. Its queue entry is skipped when popped.
+    if (!job.state.compare_exchange_strong(expected, Job::Running, std::memory_order_acq_rel))
+        return false;
+
+    job.process();
+    numRunInline.fetch_add(1, std::memory_order_relaxed);
+    job.state.store(Job::Idle, std::memory_order_release);
+    return true;
+}
+
+bool SpectralWorkerPool::tryComplete(Job& job)
+{
+    if (runIfNotStarted(job))
+        return true;
+
+    // Running on a worker past its deadline: the caller must not touch its
+    // data yet, but it does not wait either
+    if (job.state.load(std::memory_order_acquire) == Job::Running)
+    {
+        numLate.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    job.state.store(Job::Idle, std::memory_order_relaxed);
+    return true;
+}
+
+void SpectralWorkerPool::complete(Job& job)
+{
+    if (runIfNotStarted(job))
+        return;
+
+    // Already running on a worker: it finishes within one frame's work
+    while (job.state.load(std::memory_order_acquire) == Job::Running)
+        std::this_thread::yield();
+
+    job.state.store(Job::Idle, std::memory_order_relaxed);
+}
+
+void SpectralWorkerPool::release(Job& job)
+{
+    complete(job);
+
+    while (job.queueEntries.load(std::memory_order_acquire) > 0)
+    {
+        workAvailable.release();
+        std::this_thread::yield();
+    }
+}
+
+SpectralWorkerPool::Job* SpectralWorkerPool::findWork(size_t workerIndex)
+{
+    for (size_t i = 0; i < queues.size(); ++i)
+        if (auto* job = queues[(workerIndex + i) % queues.size()]->pop())
+            return job;
+
+    return nullptr;
+}
+
+void SpectralWorkerPool::runFromQueue(Job& job)
+{
+    int expected = Job::Queued;
+
+    if (job.state.compare_exchange_strong(expected, Job::Running, std::memory_order_acq_rel))
+    {
+        job.process();
+        numRunByPool.fetch_add(1, std::memory_order_relaxed);
+        job.state.store(Job::Done, std::memory_order_release);
+    }
+
+    // Last touch: after this the owner may destroy the job
+    job.queueEntries.fetch_sub(1, std::memory_order_release);
+}
+
+//==============================================================================
+SpectralWorkerPool::Queue::Queue(int capacity)
+{
+    const int size = juce::nextPowerOfTwo(capacity);
+    slots = std::make_unique<Slot[]>(static_cast<size_t>(size));
+    mask = static_cast<juce::uint64>(size - 1);
+
+    for (int i = 0; i < size; ++i)
+        slots[static_cast<size_t>(i)].sequence.store(static_cast<juce::uint64>(i), std::memory_order_relaxed);
+}
+
+bool SpectralWorkerPool::Queue::push(Job* job)
+{
+    auto position = head.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        auto& slot = slots[static_cast<size_t>(position & mask)];
+        const auto difference = static_cast<juce::int64>(slot.sequence.load(std::memory_order_acquire) - position);
+
+        if (difference == 0)
+        {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.job = job;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false;  // Full
+        }
+        else
+        {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+SpectralWorkerPool::Job* SpectralWorkerPool::Queue::pop()
+{
+    auto position = tail.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        auto& slot = slots[static_cast<size_t>(position & mask)];
+        const auto difference = static_cast<juce::int64>(slot.sequence.load(std::memory_order_acquire) - (position + 1));
+
+        if (difference == 0)
+        {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                auto* job = slot.job;
+                slot.sequence.store(position + mask + 1, std::memory_order_release);
+                return job;
+            }
+        }
+        else if (difference < 0)
+        {
+            return nullptr;  // Empty
+        }
+        else
+        {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <memory>
+#include <semaphore>
+#include <vector>
+
+/**
+ * Process-wide worker pool for per-hop spectral jobs
+ * Shared by every plugin instance through juce::SharedResourcePointer. Each
+ * worker has its own queue; submissions are dealt round-robin and idle
+ * workers steal from the others. A job's owner calls tryComplete() at its
+ * deadline: a job nobody has started yet is taken back and run inline, one
+ * still running is left alone and reported late, so the audio thread never
+ * waits. Waking a worker never takes a lock.
+ */
+class SpectralWorkerPool
+{
+public:
+    class Job
+    {
+    public:
+        virtual ~Job() = default;
+
+        // Runs on a pool thread or, as the fallback, on the owner's thread
+        virtual void process() = 0;
+
+    private:
+        friend class SpectralWorkerPool;
+
+        enum State
+        {
+            Idle,
+            Queued,
+            Running,
+            Done
+        };
+
+        std::atomic<int> state{Idle};
+        std::atomic<int> queueEntries{0};  // Queue slots still pointing here
+    };
+
+    SpectralWorkerPool();
+    ~SpectralWorkerPool();
+
+    // Starts the worker threads once; never call from the audio thread.
+    // Until then submit() refuses every job.
+    void start();
+    bool isStarted() const { return started.load(std::memory_order_relaxed); }
+
+    // Audio thread. Returns false if the job could not be queued, in which
+    // case the caller runs it itself.
+    bool submit(Job& job);
+
+    // Audio thread, at the job's deadline or before touching what it works
+    // on. Returns true once the job is idle and its results are visible to
+    // the caller; false (without waiting) if a pool thread is still running
+    // it, which counts as late. Call again at the next deadline.
+    bool tryComplete(Job& job);
+
+    // Waits for a running job to finish. Message thread only (prepare,
+    // teardown), while the audio thread is not processing; the audio thread
+    // uses tryComplete().
+    void complete(Job& job);
+
+    // Before destroying a job: completes it and waits until no queue holds it
+    void release(Job& job);
+
+    int getNumThreads() const { return static_cast<int>(workers.size()); }
+    juce::int64 getNumRunByPool() const { return numRunByPool.load(std::memory_order_relaxed); }
+    juce::int64 getNumRunInline() const { return numRunInline.load(std::memory_order_relaxed); }
+    juce::int64 getNumLate() const { return numLate.load(std::memory_order_relaxed); }
+
+private:
+    // Bounded multi-producer/multi-consumer ring (Vyukov)
+    class Queue
+    {
+    public:
+        explicit Queue(int capacity);
+
+        bool push(Job* job);
+        Job* pop();
+
+    private:
+        struct Slot
+        {
+            std::atomic<juce::uint64> sequence{0};
+            Job* job = nullptr;
+        };
+
+        std::unique_ptr<Slot[]> slots;
+        juce::uint64 mask = 0;
+        std::atomic<juce::uint64> head{0};
+        std::atomic<juce::uint64> tail{0};
+    };
+
+    class Worker;
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<juce::uint32> nextQueue{0};
+    std::atomic<bool> started{false};
+    juce::CriticalSection startLock;
+
+    // One permit per submitted job; releasing is a lock-free atomic (and a
+    // futex wake only when a worker is asleep)
+    std::counting_semaphore<> workAvailable{0};
+
+    std::atomic<juce::int64> numRunByPool{0};
+    std::atomic<juce::int64> numRunInline{0};
+    std::atomic<juce::int64> numLate{0};
+
+    Job* findWork(size_t workerIndex);
+    bool runIfNotStarted(Job& job);
+    void runFromQueue(Job& job);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectralWorkerPool)
+};
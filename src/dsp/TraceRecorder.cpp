@@ -0,0 +1,159 @@
+#include "TraceRecorder.h"
+
+std::atomic<TraceRecorder*> TraceRecorder::instance{nullptr};
+
+TraceRecorder::TraceRecorder(const juce::File& outputFile, int capacity)
+    : juce::Thread("MCC trace writer"), file(outputFile)
+{
+    const int size = juce::nextPowerOfTwo(juce::jmax(2, capacity));
+    slots = std::make_unique<Slot[]>(static_cast<size_t>(size));
+    mask = static_cast<juce::uint64>(size - 1);
+
+    for (int i = 0; i < size; ++i)
+        slots[static_cast<size_t>(i)].sequence.store(static_cast<juce::uint64>(i), std::memory_order_relaxed);
+
+    startTicks = juce::Time::getHighResolutionTicks();
+    microsecondsPerTick = 1.0e6 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+
+    file.deleteFile();
+    stream = std::make_unique<juce::FileOutputStream>(file);
+
+    if (stream->failedToOpen())
+    {
+        DBG("Could not open trace file " << file.getFullPathName());
+        stream.reset();
+        return;
+    }
+
+    write("{\"traceEvents\":[\n"
+          "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Multi-Color Comp\"}}");
+
+    // Only one recorder per process receives events
+    TraceRecorder* expected = nullptr;
+    instance.compare_exchange_strong(expected, this);
+
+    startThread();
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    TraceRecorder* expected = this;
+    instance.compare_exchange_strong(expected, nullptr);
+
+    stopThread(2000);
+
+    if (stream != nullptr)
+    {
+        drain();
+        write("\n]}\n");
+        stream->flush();
+    }
+}
+
+juce::File TraceRecorder::getDefaultOutputFile()
+{
+    const auto path = juce::SystemStats::getEnvironmentVariable("MCC_TRACE_FILE", {});
+
+    if (path.isNotEmpty())
+        return juce::File::getCurrentWorkingDirectory().getChildFile(path);
+
+    return juce::File::getSpecialLocation(juce::File::tempDirectory)
+        .getChildFile("mcc-trace-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".json");
+}
+
+void TraceRecorder::record(const char* name, char phase) noexcept
+{
+    auto* recorder = instance.load(std::memory_order_acquire);
+
+    if (recorder == nullptr)
+        return;
+
+    Event event;
+    event.name = name;
+    event.ticks = juce::Time::getHighResolutionTicks();
+    event.threadId = static_cast<juce::uint64>(reinterpret_cast<juce::pointer_sized_uint>(juce::Thread::getCurrentThreadId()));
+    event.phase = phase;
+
+    recorder->push(event);
+}
+
+void TraceRecorder::push(const Event& event) noexcept
+{
+    auto position = head.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        auto& slot = slots[static_cast<size_t>(position & mask)];
+        const auto sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<juce::int64>(sequence - position);
+
+        if (difference == 0)
+        {
+            // Slot is free: claim it
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                slot.event = event;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return;
+            }
+        }
+        else if (difference < 0)
+        {
+            // Writer has fallen a whole lap behind
+            numDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool TraceRecorder::pop(Event& event)
+{
+    auto& slot = slots[static_cast<size_t>(tail & mask)];
+
+    if (slot.sequence.load(std::memory_order_acquire) != tail + 1)
+        return false;
+
+    event = slot.event;
+    slot.sequence.store(tail + mask + 1, std::memory_order_release);
+    ++tail;
+    return true;
+}
+
+void TraceRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        drain();
+        wait(50);
+    }
+}
+
+void TraceRecorder::drain()
+{
+    Event event;
+
+    while (pop(event))
+    {
+        // Small, stable thread numbers read better in the viewer than raw IDs
+        const auto [it, isNew] = threadNumbers.try_emplace(event.threadId, static_cast<int>(threadNumbers.size()) + 1);
+
+        if (isNew)
+            write(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + juce::String(it->second)
+                  + ",\"args\":{\"name\":\"Thread " + juce::String(it->second) + "\"}}");
+
+        const double micros = static_cast<double>(event.ticks - startTicks) * microsecondsPerTick;
+
+        write(",\n{\"name\":\"" + juce::String(event.name) + "\",\"ph\":\"" + juce::String::charToString(event.phase)
+              + "\",\"ts\":" + juce::String(micros, 3) + ",\"pid\":1,\"tid\":" + juce::String(it->second) + "}");
+    }
+}
+
+void TraceRecorder::write(const juce::String& json)
+{
+    if (stream != nullptr)
+        stream->writeText(json, false, false, nullptr);
+}
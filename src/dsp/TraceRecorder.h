@@ -0,0 +1,98 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <map>
+#include <memory>
+
+#ifndef MCC_ENABLE_TRACING
+ #define MCC_ENABLE_TRACING 0
+#endif
+
+/**
+ * Audio-thread event tracing to a Chrome trace file (chrome://tracing, Perfetto)
+ * Begin/end events go into a preallocated lock-free ring that any number of
+ * threads may write; a background thread drains it to JSON. The scope macros
+ * are compiled in with the MCC_ENABLE_TRACING CMake option and expand to
+ * nothing otherwise.
+ */
+class TraceRecorder : private juce::Thread
+{
+public:
+    static constexpr int defaultCapacity = 1 << 16;
+
+    explicit TraceRecorder(const juce::File& outputFile = getDefaultOutputFile(), int capacity = defaultCapacity);
+    ~TraceRecorder() override;
+
+    // Real-time safe. Events are dropped when the ring is full or no
+    // recorder exists.
+    static void begin(const char* name) noexcept { record(name, 'B'); }
+    static void end(const char* name) noexcept { record(name, 'E'); }
+
+    const juce::File& getOutputFile() const { return file; }
+    juce::int64 getNumDropped() const { return numDropped.load(std::memory_order_relaxed); }
+
+    // $MCC_TRACE_FILE, or a timestamped file in the temp directory
+    static juce::File getDefaultOutputFile();
+
+private:
+    struct Event
+    {
+        const char* name = nullptr;  // String literal
+        juce::int64 ticks = 0;
+        juce::uint64 threadId = 0;
+        char phase = 'B';
+    };
+
+    // Bounded MPSC ring: a slot's sequence says whether it is free or filled
+    struct Slot
+    {
+        std::atomic<juce::uint64> sequence{0};
+        Event event;
+    };
+
+    static std::atomic<TraceRecorder*> instance;
+
+    juce::File file;
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    std::unique_ptr<Slot[]> slots;
+    juce::uint64 mask = 0;
+    std::atomic<juce::uint64> head{0};
+    juce::uint64 tail = 0;
+    std::atomic<juce::int64> numDropped{0};
+
+    // Writer thread only
+    juce::int64 startTicks = 0;
+    double microsecondsPerTick = 1.0;
+    std::map<juce::uint64, int> threadNumbers;
+
+    static void record(const char* name, char phase) noexcept;
+    void push(const Event& event) noexcept;
+    bool pop(Event& event);
+
+    void run() override;
+    void drain();
+    void write(const juce::String& json);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TraceRecorder)
+};
+
+/** Emits a begin event now and the matching end event when it goes out of scope */
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* n) noexcept : name(n) { TraceRecorder::begin(name); }
+    ~TraceScope() { TraceRecorder::end(name); }
+
+private:
+    const char* name;
+
+    JUCE_DECLARE_NON_COPYABLE(TraceScope)
+};
+
+#if MCC_ENABLE_TRACING
+ #define MCC_TRACE_SCOPE(name) const TraceScope JUCE_JOIN_MACRO(mccTraceScope_, __LINE__)(name)
+#else
+ #define MCC_TRACE_SCOPE(name)
+#endif
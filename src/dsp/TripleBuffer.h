@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/**
+ * Latest-value handoff from one writer thread to one reader thread
+ * The writer fills its back slot and swaps it with the middle one; the reader
+ * swaps the middle slot for its own only when something new was published.
+ * Neither side blocks or allocates, and stale values are simply overwritten.
+ */
+template <typename ItemType>
+class TripleBuffer
+{
+public:
+    // Writer side: fill this, then publish()
+    ItemType& getWriteBuffer() { return slots[static_cast<size_t>(writeIndex)]; }
+
+    void publish()
+    {
+        writeIndex = middle.exchange(writeIndex | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader side. Returns true if a newer value replaced getReadBuffer().
+    bool fetch()
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0)
+            return false;
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const ItemType& getReadBuffer() const { return slots[static_cast<size_t>(readIndex)]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshBit = 4;
+
+    std::array<ItemType, 3> slots{};
+    int writeIndex = 0;
+    int readIndex = 1;
+    std::atomic<int> middle{2};
+};
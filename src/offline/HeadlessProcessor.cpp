@@ -0,0 +1,59 @@
+#include "HeadlessProcessor.h"
+
+HeadlessProcessor::HeadlessProcessor()
+    : ChainProcessor(LatencyReporting::Immediate)
+{
+}
+
+HeadlessProcessor::~HeadlessProcessor()
+{
+}
+
+juce::Result HeadlessProcessor::loadState(const juce::XmlElement& xml)
+{
+    auto& apvts = parameters.getAPVTS();
+
+    if (!xml.hasTagName(apvts.state.getType()))
+        return juce::Result::fail("Not a Multi-Color Comp state (expected <" + apvts.state.getType().toString() + ">)");
+
+    apvts.replaceState(juce::ValueTree::fromXml(xml));
+    return juce::Result::ok();
+}
+
+juce::Result HeadlessProcessor::loadStateFile(const juce::File& file)
+{
+    auto xml = juce::XmlDocument::parse(file);
+
+    if (xml == nullptr)
+        return juce::Result::fail("Could not parse " + file.getFullPathName());
+
+    return loadState(*xml);
+}
+
+juce::Result HeadlessProcessor::setParameter(const juce::String& paramID, const juce::String& value)
+{
+    auto* param = parameters.getAPVTS().getParameter(paramID);
+
+    if (param == nullptr)
+        return juce::Result::fail("Unknown parameter: " + paramID);
+
+    float plainValue = 0.0f;
+
+    if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(param))
+    {
+        // Accept the choice name as well as its index
+        const int index = choice->choices.indexOf(value, true);
+        plainValue = index >= 0 ? static_cast<float>(index) : value.getFloatValue();
+    }
+    else if (dynamic_cast<juce::AudioParameterBool*>(param) != nullptr)
+    {
+        plainValue = (value.equalsIgnoreCase("true") || value.equalsIgnoreCase("on") || value.getIntValue() != 0) ? 1.0f : 0.0f;
+    }
+    else
+    {
+        plainValue = value.getFloatValue();
+    }
+
+    param->setValueNotifyingHost(param->convertTo0to1(plainValue));
+    return juce::Result::ok();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../ChainProcessor.h"
+
+/**
+ * Plugin-less host for the DSP chain
+ * Runs the same ChainProcessor as the plugin, minus the editor, so
+ * command-line tools process exactly what the plugin does. Latency changes
+ * are reported as soon as a block has run.
+ * Configure it before processing starts: parameter changes are not
+ * synchronised with a running render.
+ */
+class HeadlessProcessor : public ChainProcessor
+{
+public:
+    HeadlessProcessor();
+    ~HeadlessProcessor() override;
+
+    // Preset files: APVTS XML, as the plugin saved before its binary format
+    juce::Result loadState(const juce::XmlElement& xml);
+    juce::Result loadStateFile(const juce::File& file);
+
+    // Value in the parameter's own units; choices also accept their name
+    juce::Result setParameter(const juce::String& paramID, const juce::String& value);
+
+    const juce::String getName() const override { return "MultiColorComp (headless)"; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HeadlessProcessor)
+};
@@ -0,0 +1,142 @@
+#include "OfflineRenderer.h"
+
+OfflineRenderer::OfflineRenderer(HeadlessProcessor& p)
+    : processor(p)
+{
+    formatManager.registerBasicFormats();
+}
+
+OfflineRenderer::Result OfflineRenderer::render(const juce::File& input, const juce::File& output, const Options& options)
+{
+    Result result;
+    const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+    auto fail = [&result](const juce::String& message) {
+        result.status = juce::Result::fail(message);
+        return result;
+    };
+
+    auto* inputFormat = formatManager.findFormatForFileExtension(input.getFileExtension());
+    if (inputFormat == nullptr)
+        return fail("Unsupported input format: " + input.getFileName());
+
+    // Prefer a memory-mapped reader; not every format supports one
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> mappedReader(inputFormat->createMemoryMappedReader(input));
+    std::unique_ptr<juce::AudioFormatReader> bufferedReader;
+    juce::AudioFormatReader* reader = mappedReader.get();
+
+    if (reader == nullptr)
+    {
+        bufferedReader.reset(formatManager.createReaderFor(input));
+        reader = bufferedReader.get();
+    }
+
+    if (reader == nullptr)
+        return fail("Could not open " + input.getFileName());
+
+    if (reader->numChannels < 1 || reader->numChannels > 2)
+        return fail(input.getFileName() + ": only mono and stereo files are supported");
+
+    auto* outputFormat = formatManager.findFormatForFileExtension(output.getFileExtension());
+    if (outputFormat == nullptr)
+        return fail("Unsupported output format: " + output.getFileName());
+
+    const int bitDepth = options.bitDepth > 0 ? options.bitDepth : static_cast<int>(reader->bitsPerSample);
+    if (!outputFormat->getPossibleBitDepths().contains(bitDepth))
+        return fail(outputFormat->getFormatName() + " cannot be written at " + juce::String(bitDepth) + " bits");
+
+    const int numChannels = static_cast<int>(reader->numChannels);
+    const double sampleRate = reader->sampleRate;
+    const int blockSize = juce::jmax(1, options.blockSize);
+
+    output.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(output);
+    if (stream->failedToOpen())
+        return fail("Could not write " + output.getFullPathName());
+
+    std::unique_ptr<juce::AudioFormatWriter> writer(outputFormat->createWriterFor(stream.get(), sampleRate,
+                                                                                  static_cast<unsigned int>(numChannels),
+                                                                                  bitDepth, reader->metadataValues, 0));
+    if (writer == nullptr)
+        return fail("Could not create a writer for " + output.getFileName());
+
+    stream.release();  // Owned by the writer from here
+
+    processor.setPlayConfigDetails(numChannels, numChannels, sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    // Every return from here, failed or not, leaves the processor released
+    const juce::ScopeGuard releaseProcessor{[this] { processor.releaseResources(); }};
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize);
+    juce::MidiBuffer midi;
+
+    const juce::int64 inputLength = reader->lengthInSamples;
+    const juce::int64 mapWindow = juce::jmax(static_cast<juce::int64>(blockSize), static_cast<juce::int64>(sampleRate * mapWindowSeconds));
+
+    juce::int64 outputLength = inputLength;
+    juce::int64 readPosition = 0;
+    juce::int64 written = 0;
+    juce::int64 latencyToSkip = 0;
+    bool firstBlock = true;
+
+    while (written < outputLength)
+    {
+        buffer.clear();
+
+        // Past the end of the input the chain is fed silence to flush it
+        const int numToRead = static_cast<int>(juce::jlimit(static_cast<juce::int64>(0), static_cast<juce::int64>(blockSize), inputLength - readPosition));
+
+        if (numToRead > 0)
+        {
+            if (mappedReader != nullptr)
+            {
+                // Slide the mapped window forward instead of mapping the whole file
+                const juce::Range<juce::int64> needed(readPosition, readPosition + numToRead);
+
+                if (!mappedReader->getMappedSection().contains(needed)
+                    && !mappedReader->mapSectionOfFile({readPosition, juce::jmin(inputLength, readPosition + mapWindow)}))
+                    return fail("Could not map " + input.getFileName());
+            }
+
+            if (!reader->read(&buffer, 0, numToRead, readPosition, true, true))
+                return fail("Read error in " + input.getFileName());
+
+            readPosition += numToRead;
+        }
+
+        processor.processBlock(buffer, midi);
+
+        // Latency depends on parameters applied inside the first block
+        if (firstBlock)
+        {
+            firstBlock = false;
+            latencyToSkip = processor.getLatencySamples();
+
+            if (options.appendTail)
+                outputLength += processor.getRouter().getTailSamples();
+        }
+
+        const int offset = static_cast<int>(juce::jmin(latencyToSkip, static_cast<juce::int64>(blockSize)));
+        latencyToSkip -= offset;
+
+        const int numToWrite = static_cast<int>(juce::jmin(static_cast<juce::int64>(blockSize - offset), outputLength - written));
+
+        if (numToWrite > 0)
+        {
+            if (!writer->writeFromAudioSampleBuffer(buffer, offset, numToWrite))
+                return fail("Write error in " + output.getFileName());
+
+            written += numToWrite;
+        }
+    }
+
+    writer.reset();  // Flushes and finalises the header
+
+    result.numSamples = written;
+    result.sampleRate = sampleRate;
+    result.outputLoudness = processor.getRouter().getOutputLoudness();
+
+    result.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+    return result;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include "HeadlessProcessor.h"
+
+/**
+ * Streams one audio file through a HeadlessProcessor
+ * Input is read in fixed-size blocks through a sliding memory-mapped window
+ * (or a buffered reader for formats that cannot be mapped), so memory use
+ * does not grow with file length. The output is latency-compensated: it
+ * lines up sample-for-sample with the input.
+ */
+class OfflineRenderer
+{
+public:
+    struct Options
+    {
+        int blockSize = 512;
+        int bitDepth = 0;         // 0 = same as the input
+        bool appendTail = false;  // keep rendering the chain's ring-out after the input ends
+    };
+
+    struct Result
+    {
+        juce::Result status = juce::Result::ok();
+        juce::int64 numSamples = 0;
+        double sampleRate = 0.0;
+        double renderSeconds = 0.0;
+        LoudnessReadings outputLoudness;
+    };
+
+    explicit OfflineRenderer(HeadlessProcessor& processor);
+
+    Result render(const juce::File& input, const juce::File& output, const Options& options);
+
+private:
+    HeadlessProcessor& processor;
+    juce::AudioFormatManager formatManager;
+
+    // Seconds of input kept mapped at once
+    static constexpr double mapWindowSeconds = 30.0;
+};
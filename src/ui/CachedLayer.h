@@ -0,0 +1,45 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+/**
+ * Image of artwork that does not change between repaints
+ * Rendered at the display's physical scale the first time it is drawn and
+ * again only when the size or scale changes, or after invalidate().
+ */
+class CachedLayer
+{
+public:
+    // paintLayer draws the artwork with its top-left corner at (0, 0)
+    template <typename PaintFunction>
+    void draw(juce::Graphics& g, juce::Rectangle<int> bounds, PaintFunction&& paintLayer)
+    {
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (!image.isValid() || bounds.getWidth() != width || bounds.getHeight() != height || scale != imageScale)
+        {
+            width = bounds.getWidth();
+            height = bounds.getHeight();
+            imageScale = scale;
+
+            image = juce::Image(juce::Image::ARGB,
+                                juce::jmax(1, juce::roundToInt(static_cast<float>(width) * scale)),
+                                juce::jmax(1, juce::roundToInt(static_cast<float>(height) * scale)), true);
+
+            juce::Graphics layer(image);
+            layer.addTransform(juce::AffineTransform::scale(scale));
+            paintLayer(layer);
+        }
+
+        g.setOpacity(1.0f);
+        g.drawImage(image, bounds.toFloat());
+    }
+
+    void invalidate() { image = {}; }
+
+private:
+    juce::Image image;
+    int width = 0;
+    int height = 0;
+    float imageScale = 0.0f;
+};
@@ -0,0 +1,128 @@
+#include "GainReductionGraph.h"
+#include "ModernLookAndFeel.h"
+
+GainReductionGraph::GainReductionGraph(juce::Colour grColour)
+    : colour(grColour)
+{
+    setInterceptsMouseClicks(false, false);
+    setOpaque(true);
+}
+
+void GainReductionGraph::resized()
+{
+    // Starts empty at the new size
+    history = juce::Image(juce::Image::RGB, std::max(1, getWidth()), std::max(1, getHeight()), false);
+
+    juce::Graphics g(history);
+    g.fillAll(ModernLookAndFeel::darkBg);
+
+    numPendingColumns = 0;
+    quietColumns = 0;
+}
+
+void GainReductionGraph::addPoint(const GainReductionPoint& point)
+{
+    if (pointsInColumn == 0)
+        column = point;
+    else
+    {
+        column.grMin = std::min(column.grMin, point.grMin);
+        column.grMax = std::max(column.grMax, point.grMax);
+        column.inputPeak = std::max(column.inputPeak, point.inputPeak);
+    }
+
+    if (++pointsInColumn < pointsPerColumn)
+        return;
+
+    pointsInColumn = 0;
+
+    // A stalled editor only needs the newest columns
+    if (numPendingColumns == maxPendingColumns)
+    {
+        std::move(pendingColumns.begin() + 1, pendingColumns.end(), pendingColumns.begin());
+        --numPendingColumns;
+    }
+
+    pendingColumns[static_cast<size_t>(numPendingColumns++)] = column;
+}
+
+void GainReductionGraph::flush()
+{
+    if (numPendingColumns == 0)
+        return;
+
+    const int width = history.getWidth();
+    const int height = history.getHeight();
+    const int shift = std::min(numPendingColumns, width);
+
+    // Silence scrolling over a graph that already shows only silence changes
+    // no pixels, so an idle editor neither redraws nor repaints
+    const bool wasQuiet = quietColumns >= width;
+    bool allQuiet = true;
+
+    for (int i = 0; i < numPendingColumns; ++i)
+    {
+        if (isQuiet(pendingColumns[static_cast<size_t>(i)]))
+            quietColumns = std::min(quietColumns + 1, width);
+        else
+        {
+            quietColumns = 0;
+            allQuiet = false;
+        }
+    }
+
+    if (wasQuiet && allQuiet)
+    {
+        numPendingColumns = 0;
+        return;
+    }
+
+    history.moveImageSection(0, 0, shift, 0, width - shift, height);
+
+    juce::Graphics g(history);
+    const int firstColumn = numPendingColumns - shift;
+
+    for (int i = 0; i < shift; ++i)
+        drawColumn(g, width - shift + i, pendingColumns[static_cast<size_t>(firstColumn + i)]);
+
+    numPendingColumns = 0;
+    repaint();
+}
+
+bool GainReductionGraph::isQuiet(const GainReductionPoint& point)
+{
+    return point.grMin > -0.05f && point.inputPeak <= juce::Decibels::decibelsToGain(levelFloorDB);
+}
+
+void GainReductionGraph::drawColumn(juce::Graphics& g, int x, const GainReductionPoint& point) const
+{
+    const float height = static_cast<float>(history.getHeight());
+
+    g.setColour(ModernLookAndFeel::darkBg);
+    g.fillRect(x, 0, 1, history.getHeight());
+
+    // Input level rises from the bottom
+    const float levelDB = juce::Decibels::gainToDecibels(point.inputPeak, levelFloorDB);
+    const float levelTop = height * levelDB / levelFloorDB;
+    g.setColour(ModernLookAndFeel::textSecondary.withAlpha(0.25f));
+    g.fillRect(static_cast<float>(x), levelTop, 1.0f, height - levelTop);
+
+    // Gain reduction hangs from the top: filled to the shallowest value, the
+    // span down to the deepest drawn solid
+    auto grToY = [height](float grDB) {
+        return height * juce::jlimit(0.0f, 1.0f, -grDB / grRangeDB);
+    };
+
+    const float shallowY = grToY(point.grMax);
+    const float deepY = grToY(point.grMin);
+
+    g.setColour(colour.withAlpha(0.3f));
+    g.fillRect(static_cast<float>(x), 0.0f, 1.0f, shallowY);
+    g.setColour(colour);
+    g.fillRect(static_cast<float>(x), shallowY, 1.0f, std::max(1.0f, deepY - shallowY));
+}
+
+void GainReductionGraph::paint(juce::Graphics& g)
+{
+    g.drawImageAt(history, 0, 0);
+}
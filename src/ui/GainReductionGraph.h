@@ -0,0 +1,45 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "../dsp/GainReductionHistory.h"
+#include <array>
+
+/**
+ * Scrolling compressor gain-reduction and input-level history
+ * Each pixel column covers a few milliseconds of GR points. The history is
+ * kept in an image: new columns shift it left and only they are drawn.
+ */
+class GainReductionGraph : public juce::Component
+{
+public:
+    explicit GainReductionGraph(juce::Colour grColour);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    // Editor timer: add the points drained from the history, then flush()
+    void addPoint(const GainReductionPoint& point);
+    void flush();
+
+private:
+    static constexpr int pointsPerColumn = 10;  // 10 ms per pixel
+    static constexpr int maxPendingColumns = 64;
+    static constexpr float grRangeDB = 20.0f;
+    static constexpr float levelFloorDB = -60.0f;
+
+    juce::Colour colour;
+    juce::Image history;
+
+    GainReductionPoint column;
+    int pointsInColumn = 0;
+    std::array<GainReductionPoint, maxPendingColumns> pendingColumns;
+    int numPendingColumns = 0;
+
+    // Consecutive columns with no GR and no input at the right edge
+    int quietColumns = 0;
+
+    static bool isQuiet(const GainReductionPoint& point);
+    void drawColumn(juce::Graphics& g, int x, const GainReductionPoint& point) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GainReductionGraph)
+};
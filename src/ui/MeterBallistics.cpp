@@ -0,0 +1,52 @@
+#include "MeterBallistics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float rmsTimeSeconds = 0.3f;
+    constexpr float peakFallDBPerSecond = 20.0f;
+    constexpr float grRecoveryDBPerSecond = 30.0f;
+}
+
+void MeterBallistics::reset()
+{
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        input[ch] = LevelState();
+        output[ch] = LevelState();
+    }
+
+    gainReduction = 0.0f;
+    inputLoudness = {};
+    outputLoudness = {};
+}
+
+void MeterBallistics::addFrame(const MeterFrame& frame)
+{
+    const float seconds = frame.durationSeconds;
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        input[ch].update(frame.inputPeak[ch], frame.inputRMS[ch], seconds);
+        output[ch].update(frame.outputPeak[ch], frame.outputRMS[ch], seconds);
+    }
+
+    // Hold the deepest reduction, recover towards it at a fixed rate
+    gainReduction = std::min(frame.grMin, std::min(0.0f, gainReduction + grRecoveryDBPerSecond * seconds));
+
+    inputLoudness = frame.inputLoudness;
+    outputLoudness = frame.outputLoudness;
+}
+
+void MeterBallistics::LevelState::update(float blockPeak, float blockRMS, float seconds)
+{
+    // RMS: average energy rather than amplitude
+    const float coeff = 1.0f - std::exp(-seconds / rmsTimeSeconds);
+    energy += (blockRMS * blockRMS - energy) * coeff;
+    rms = std::sqrt(energy);
+
+    // Peak: instant attack, constant fall in dB
+    const float fall = std::pow(10.0f, -peakFallDBPerSecond * seconds / 20.0f);
+    peak = std::max(blockPeak, peak * fall);
+}
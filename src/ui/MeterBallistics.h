@@ -0,0 +1,44 @@
+#pragma once
+
+#include "../dsp/Metering.h"
+
+/**
+ * UI-side meter ballistics fed by per-block MeterFrames
+ * Peaks attack instantly and fall at a fixed dB rate, RMS is averaged
+ * over ~300 ms, and gain reduction holds its deepest value then recovers.
+ */
+class MeterBallistics
+{
+public:
+    MeterBallistics() = default;
+
+    void reset();
+    void addFrame(const MeterFrame& frame);
+
+    float getInputRMS(int channel) const { return input[channel].rms; }
+    float getInputPeak(int channel) const { return input[channel].peak; }
+    float getOutputRMS(int channel) const { return output[channel].rms; }
+    float getOutputPeak(int channel) const { return output[channel].peak; }
+    float getGainReduction() const { return gainReduction; }
+
+    // Loudness is already integrated on the audio thread; the latest frame wins
+    const LoudnessReadings& getInputLoudness() const { return inputLoudness; }
+    const LoudnessReadings& getOutputLoudness() const { return outputLoudness; }
+
+private:
+    struct LevelState
+    {
+        float rms = 0.0f;
+        float peak = 0.0f;
+        float energy = 0.0f;
+
+        void update(float blockPeak, float blockRMS, float seconds);
+    };
+
+    LevelState input[2];
+    LevelState output[2];
+    float gainReduction = 0.0f;
+
+    LoudnessReadings inputLoudness;
+    LoudnessReadings outputLoudness;
+};
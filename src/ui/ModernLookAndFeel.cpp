@@ -29,18 +29,26 @@ void ModernLookAndFeel::drawRotarySlider(juce::Graphics& g, int x, int y, int wi
     auto lineW = juce::jmin(8.0f, radius * 0.3f);
     auto arcRadius = radius - lineW * 0.5f;
 
-    // Background arc
-    juce::Path backgroundArc;
-    backgroundArc.addCentredArc(bounds.getCentreX(),
-                               bounds.getCentreY(),
-                               arcRadius, arcRadius,
-                               0.0f,
-                               rotaryStartAngle,
-                               rotaryEndAngle,
-                               true);
-
-    g.setColour(darkBorder);
-    g.strokePath(backgroundArc, juce::PathStrokeType(lineW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+    // Background arc, cached per knob size (a resize just adds new entries)
+    if (rotaryScales.size() > 32)
+        rotaryScales.clear();
+
+    auto& scale = rotaryScales[{width, height, rotaryStartAngle, rotaryEndAngle}];
+    scale.draw(g, {x, y, width, height}, [&](juce::Graphics& layer) {
+        const auto centre = bounds.getCentre() - juce::Point<float>(static_cast<float>(x), static_cast<float>(y));
+
+        juce::Path backgroundArc;
+        backgroundArc.addCentredArc(centre.x,
+                                   centre.y,
+                                   arcRadius, arcRadius,
+                                   0.0f,
+                                   rotaryStartAngle,
+                                   rotaryEndAngle,
+                                   true);
+
+        layer.setColour(darkBorder);
+        layer.strokePath(backgroundArc, juce::PathStrokeType(lineW, juce::PathStrokeType::curved, juce::PathStrokeType::rounded));
+    });
 
     // Value arc
     if (sliderPos > 0.0f)
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <juce_gui_basics/juce_gui_basics.h>
+#include "CachedLayer.h"
+#include <map>
+#include <tuple>
 
 class ModernLookAndFeel : public juce::LookAndFeel_V4
 {
@@ -27,4 +30,10 @@ public:
                              bool shouldDrawButtonAsHighlighted, bool shouldDrawButtonAsDown) override;
 
     juce::Font getTextButtonFont(juce::TextButton&, int buttonHeight) override;
+
+private:
+    // Knob scales (the background arc) never move with the value, so each
+    // knob size and angle range is rendered once and reused by every knob
+    using RotaryScaleKey = std::tuple<int, int, float, float>;
+    std::map<RotaryScaleKey, CachedLayer> rotaryScales;
 };
@@ -0,0 +1,76 @@
+#include "PerformanceOverlay.h"
+#include "ModernLookAndFeel.h"
+
+PerformanceOverlay::PerformanceOverlay(ProcessingProfiler& p)
+    : profiler(p)
+{
+    setInterceptsMouseClicks(false, false);
+}
+
+void PerformanceOverlay::update()
+{
+    for (int slot = 0; slot < ProcessingProfiler::numSlots; ++slot)
+        stats[static_cast<size_t>(slot)] = profiler.getStats(static_cast<ProcessingProfiler::Slot>(slot));
+
+    repaint();
+}
+
+void PerformanceOverlay::addEditorUpdate(double microseconds, double intervalSeconds)
+{
+    // Roughly half a second of updates at 30 Hz
+    constexpr double coeff = 0.07;
+
+    if (editorStats.averageInterval <= 0.0)
+    {
+        editorStats.averageMicroseconds = microseconds;
+        editorStats.averageInterval = intervalSeconds;
+    }
+
+    editorStats.averageMicroseconds += (microseconds - editorStats.averageMicroseconds) * coeff;
+    editorStats.averageInterval += (intervalSeconds - editorStats.averageInterval) * coeff;
+    editorStats.maxMicroseconds = juce::jmax(editorStats.maxMicroseconds, microseconds);
+}
+
+void PerformanceOverlay::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds();
+
+    g.setColour(ModernLookAndFeel::darkBg.withAlpha(0.9f));
+    g.fillRoundedRectangle(bounds.toFloat(), 8.0f);
+    g.setColour(ModernLookAndFeel::darkBorder);
+    g.drawRoundedRectangle(bounds.toFloat().reduced(0.5f), 8.0f, 1.0f);
+
+    bounds.reduce(10, 8);
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 11.0f, juce::Font::plain));
+
+    const int rowHeight = bounds.getHeight() / 7;
+    auto drawRow = [&](const juce::String& text, juce::Colour colour) {
+        g.setColour(colour);
+        g.drawText(text, bounds.removeFromTop(rowHeight), juce::Justification::centredLeft);
+    };
+
+    drawRow("stage      avg us   max us   load", ModernLookAndFeel::textSecondary);
+
+    const char* const names[] = {"soothe", "comp", "color", "total"};
+
+    for (int slot = 0; slot < ProcessingProfiler::numSlots; ++slot)
+    {
+        const auto& s = stats[static_cast<size_t>(slot)];
+        drawRow(juce::String(names[slot]).paddedRight(' ', 9)
+                    + juce::String(s.averageMicroseconds, 1).paddedLeft(' ', 8)
+                    + juce::String(s.maxMicroseconds, 1).paddedLeft(' ', 9)
+                    + (juce::String(s.averageLoad * 100.0f, 1) + "%").paddedLeft(' ', 8),
+                ModernLookAndFeel::textPrimary);
+    }
+
+    const double rate = editorStats.averageInterval > 0.0 ? 1.0 / editorStats.averageInterval : 0.0;
+    drawRow(juce::String("ui").paddedRight(' ', 9)
+                + juce::String(editorStats.averageMicroseconds, 1).paddedLeft(' ', 8)
+                + juce::String(editorStats.maxMicroseconds, 1).paddedLeft(' ', 9)
+                + (juce::String(rate, 1) + "Hz").paddedLeft(' ', 8),
+            ModernLookAndFeel::textPrimary);
+
+    const auto& total = stats[ProcessingProfiler::Total];
+    drawRow("DSP load " + juce::String(total.averageLoad * 100.0f, 1) + "% (peak " + juce::String(total.maxLoad * 100.0f, 1) + "%)",
+            total.maxLoad > 0.7f ? ModernLookAndFeel::amber : ModernLookAndFeel::emerald);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "../dsp/ProcessingProfiler.h"
+#include <array>
+
+/**
+ * Hidden developer overlay with per-module CPU time and DSP load
+ * The editor shows it on a double-click of the title; the profiler only
+ * runs while it is visible. A last row shows the editor's own meter update
+ * cost and rate, measured on the message thread.
+ */
+class PerformanceOverlay : public juce::Component
+{
+public:
+    explicit PerformanceOverlay(ProcessingProfiler& profiler);
+
+    void paint(juce::Graphics& g) override;
+
+    // Pulls the latest figures (editor update)
+    void update();
+
+    // Message thread: one editor meter update and the time since the last one
+    void addEditorUpdate(double microseconds, double intervalSeconds);
+    void resetEditorStats() { editorStats = {}; }
+
+private:
+    struct EditorStats
+    {
+        double averageMicroseconds = 0.0;
+        double maxMicroseconds = 0.0;
+        double averageInterval = 0.0;
+    };
+
+    ProcessingProfiler& profiler;
+    std::array<ProcessingProfiler::Stats, ProcessingProfiler::numSlots> stats;
+    EditorStats editorStats;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PerformanceOverlay)
+};
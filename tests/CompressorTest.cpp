@@ -3,9 +3,22 @@
 #include "../src/dsp/CompressorModule.h"
 #include "../src/dsp/ColorModule.h"
 #include "../src/dsp/SootheModule.h"
+#include "../src/dsp/SilenceDetector.h"
+#include "../src/dsp/LoudnessMeter.h"
+#include "../src/dsp/RouterModule.h"
+#include "../src/dsp/TraceRecorder.h"
 #include "../src/Parameters.h"
+#include "../src/offline/HeadlessProcessor.h"
+#include "../src/offline/OfflineRenderer.h"
+#include "../bench/Stimulus.h"
+#include <cstring>
+#include <functional>
 #include <iostream>
-#include <cassert>
+#include <limits>
+#include <map>
+#include <semaphore>
+#include <thread>
+#include "TestRegistry.h"
 
 // Simple test parameter provider
 class TestParameters : public Parameters
@@ -43,10 +56,61 @@ private:
     DummyProcessor dummyProcessor;
 };
 
-void testCompressor()
+// Sets a parameter from its plain value, notifying listeners as a host would
+static void setParam(TestParameters& params, const char* id, float plain)
 {
-    std::cout << "Testing Compressor Module..." << std::endl;
+    auto* param = params.getAPVTS().getParameter(id);
+    param->setValueNotifyingHost(param->convertTo0to1(plain));
+}
+
+struct NullResult
+{
+    int latency = 0;
+    float maxError = 0.0f;
+};
+
+// Renders two tones (440 Hz left, 1234.5 Hz right) through a fresh
+// SootheModule in blocks of blockSize, and returns the largest difference
+// from the input delayed by the reported latency, once every quality's
+// window has filled. With unityShortcut off every frame goes through the
+// attenuation and inverse FFT.
+static NullResult renderNullError(TestParameters& params, int blockSize, bool unityShortcut = true)
+{
+    constexpr int length = 16384;
+    juce::AudioBuffer<float> input(2, length), output(2, length);
+
+    for (int i = 0; i < length; ++i)
+    {
+        const float t = static_cast<float>(i) / 44100.0f;
+        input.setSample(0, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 440.0f * t));
+        input.setSample(1, i, 0.3f * std::sin(2.0f * juce::MathConstants<float>::pi * 1234.5f * t));
+    }
+
+    output.makeCopyOf(input);
+
+    SootheModule soothe;
+    soothe.setUnityShortcut(unityShortcut);
+    soothe.prepare({44100.0, static_cast<juce::uint32>(blockSize), 2});
+
+    NullResult result;
+
+    for (int start = 0; start < length; start += blockSize)
+    {
+        auto block = juce::dsp::AudioBlock<float>(output).getSubBlock(static_cast<size_t>(start),
+                                                                       static_cast<size_t>(std::min(blockSize, length - start)));
+        soothe.processActive(block, params);
+        result.latency = soothe.getLatencySamples();
+    }
+
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = soothe.getMaxLatencySamples(); i < length; ++i)
+            result.maxError = std::max(result.maxError, std::abs(output.getSample(ch, i) - input.getSample(ch, i - result.latency)));
+
+    return result;
+}
 
+TEST_CASE(testCompressor, "compressor/basic")
+{
     CompressorModule comp;
     TestParameters params;
 
@@ -82,18 +146,107 @@ void testCompressor()
         }
     }
 
-    assert(maxLevel > 0.0f && "Output is silent");
-    assert(maxLevel <= 1.0f && "Output is clipping");
+    EXPECT(maxLevel > 0.0f, "Output is silent");
+    EXPECT(maxLevel <= 1.0f, "Output is clipping");
 
     std::cout << "  Max level: " << juce::Decibels::gainToDecibels(maxLevel) << " dB" << std::endl;
     std::cout << "  Gain reduction: " << comp.getGainReduction() << " dB" << std::endl;
     std::cout << "  ✓ Compressor test passed" << std::endl;
 }
 
-void testColor()
+TEST_CASE(testGainReductionHistory, "compressor/gr-history")
 {
-    std::cout << "\nTesting Color Module..." << std::endl;
+    // One point per millisecond, carrying the block's GR extremes and the
+    // compressor's input peak; bypassed and idle stretches keep the history
+    // moving at 0 dB
+    CompressorModule comp;
+    TestParameters params;
+    GainReductionHistory history;
+
+    comp.prepare({44100.0, 440, 2});
+    history.prepare(44100.0);
+    comp.setHistory(&history);
+
+    juce::AudioBuffer<float> buffer(2, 440);
+    float deepest = 0.0f;
+
+    for (int b = 0; b < 10; ++b)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < 440; ++i)
+                buffer.setSample(ch, i, 0.9f * std::sin(2.0f * juce::MathConstants<float>::pi * 1000.0f * static_cast<float>(b * 440 + i) / 44100.0f));
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        comp.processActive(block, params);
+        deepest = std::min(deepest, comp.getBlockGainReductionMin());
+    }
+
+    int numPoints = 0;
+    float historyDeepest = 0.0f;
+    float inputPeak = 0.0f;
+    GainReductionPoint point;
+
+    while (history.pop(point))
+    {
+        ++numPoints;
+        historyDeepest = std::min(historyDeepest, point.grMin);
+        inputPeak = std::max(inputPeak, point.inputPeak);
+        EXPECT(point.grMin <= point.grMax, "GR point extremes are swapped");
+    }
 
+    std::cout << "  " << numPoints << " points, deepest " << historyDeepest << " dB" << std::endl;
+
+    EXPECT(numPoints == 100, "Expected one point per millisecond");
+    EXPECT(historyDeepest < 0.0f && std::abs(historyDeepest - deepest) < 0.5f, "History misses the deepest gain reduction");
+    EXPECT(std::abs(inputPeak - 0.9f) < 0.01f, "History input peak is wrong");
+
+    // Bypassed, the points carry the same input peak with no GR
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < 440; ++i)
+            buffer.setSample(ch, i, 0.9f * std::sin(2.0f * juce::MathConstants<float>::pi * 1000.0f * static_cast<float>(i) / 44100.0f));
+
+    juce::dsp::AudioBlock<float> input(buffer);
+    comp.addBypassedToHistory(input);
+    numPoints = 0;
+    inputPeak = 0.0f;
+
+    while (history.pop(point))
+    {
+        ++numPoints;
+        inputPeak = std::max(inputPeak, point.inputPeak);
+        EXPECT(point.grMin == 0.0f && point.grMax == 0.0f, "Bypassed points should carry no gain reduction");
+    }
+
+    EXPECT(numPoints == 10, "Bypassed samples did not advance the history");
+    EXPECT(std::abs(inputPeak - 0.9f) < 0.01f, "Bypassed input peak differs from the active one");
+
+    history.addIdle(4400);
+    numPoints = 0;
+
+    while (history.pop(point))
+    {
+        ++numPoints;
+        EXPECT(point.grMin == 0.0f && point.grMax == 0.0f, "Idle points should carry no gain reduction");
+    }
+
+    EXPECT(numPoints == 100, "Idle samples did not advance the history");
+
+    // A reader that stops draining loses the oldest points, not the newest
+    history.addIdle(GainReductionHistory::capacity * 44);
+    auto lastPoint = input.getSubBlock(0, 44);
+    comp.processActive(lastPoint, params);
+    numPoints = 0;
+
+    while (history.pop(point))
+        ++numPoints;
+
+    EXPECT(numPoints == GainReductionHistory::capacity - 1, "A full history did not keep its newest points");
+    EXPECT(point.grMin < 0.0f, "A full history dropped the newest point");
+    std::cout << "  ✓ GR history test passed" << std::endl;
+}
+
+TEST_CASE(testColor, "color/basic")
+{
     ColorModule color;
     TestParameters params;
 
@@ -129,15 +282,13 @@ void testColor()
         }
     }
 
-    assert(maxLevel > 0.0f && "Output is silent");
+    EXPECT(maxLevel > 0.0f, "Output is silent");
     std::cout << "  Max level: " << juce::Decibels::gainToDecibels(maxLevel) << " dB" << std::endl;
     std::cout << "  ✓ Color test passed" << std::endl;
 }
 
-void testBypass()
+TEST_CASE(testBypass, "compressor/bypass-null")
 {
-    std::cout << "\nTesting Bypass (null test)..." << std::endl;
-
     CompressorModule comp;
     TestParameters params;
 
@@ -181,28 +332,1494 @@ void testBypass()
         }
     }
 
-    assert(maxDiff < 0.0001f && "Bypass is not working correctly");
+    EXPECT(maxDiff < 0.0001f, "Bypass is not working correctly");
     std::cout << "  Max difference: " << maxDiff << std::endl;
     std::cout << "  ✓ Bypass test passed" << std::endl;
 }
 
-int main(int argc, char* argv[])
+TEST_CASE(testSootheFraming, "soothe/framing")
+{
+    // With zero amount the STFT (or Live's idle filter bank) must reconstruct
+    // its input, delayed by exactly the reported latency, whatever the block
+    // size or scheduling
+    const char* const schedulingNames[] = {"inline", "spread", "worker", "shared pool"};
+
+    for (int quality = 0; quality < 4; ++quality)
+    {
+        for (int scheduling = 0; scheduling < 4; ++scheduling)
+        {
+            for (int blockSize : {37, 64, 512})
+            {
+                TestParameters params;
+                setParam(params, ParamIDs::sootheAmount, 0.0f);
+                setParam(params, ParamIDs::sootheQuality, static_cast<float>(quality));
+                setParam(params, ParamIDs::sootheScheduling, static_cast<float>(scheduling));
+
+                const auto [latency, maxError] = renderNullError(params, blockSize);
+
+                EXPECT(maxError < 1.0e-4f, "Soothe STFT does not reconstruct its input at the reported latency");
+
+                if (blockSize == 64)
+                    std::cout << "  Quality " << quality << " " << schedulingNames[scheduling]
+                              << ": latency " << latency << ", max error " << maxError << std::endl;
+            }
+        }
+    }
+
+    std::cout << "  ✓ Soothe framing test passed" << std::endl;
+}
+
+TEST_CASE(testSootheSampleRates, "soothe/sample-rates")
+{
+    // FFT sizes follow the sample rate, so the window (and with Inline
+    // scheduling the latency) covers the same time at any rate, and the
+    // STFT still reconstructs its input
+    const std::pair<double, int> expectedNormalLatency[] = {{44100.0, 1024}, {48000.0, 1024}, {96000.0, 2048}, {192000.0, 4096}};
+
+    for (const auto& [sampleRate, expectedLatency] : expectedNormalLatency)
+    {
+        for (int quality = 0; quality < 4; ++quality)
+        {
+            TestParameters params;
+            setParam(params, ParamIDs::sootheAmount, 0.0f);
+            setParam(params, ParamIDs::sootheQuality, static_cast<float>(quality));
+
+            SootheModule soothe;
+            soothe.prepare({sampleRate, 512, 2});
+
+            const int length = static_cast<int>(sampleRate * 0.5);
+            juce::AudioBuffer<float> input(2, length), output(2, length);
+
+            for (int i = 0; i < length; ++i)
+            {
+                const float t = static_cast<float>(i / sampleRate);
+                input.setSample(0, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 440.0f * t));
+                input.setSample(1, i, 0.3f * std::sin(2.0f * juce::MathConstants<float>::pi * 1234.5f * t));
+            }
+
+            output.makeCopyOf(input);
+
+            for (int start = 0; start < length; start += 512)
+            {
+                auto block = juce::dsp::AudioBlock<float>(output).getSubBlock(static_cast<size_t>(start),
+                                                                               static_cast<size_t>(std::min(512, length - start)));
+                soothe.processActive(block, params);
+            }
+
+            const int latency = soothe.getLatencySamples();
+            EXPECT(latency <= soothe.getMaxLatencySamples(), "Latency exceeds the reported maximum");
+
+            if (quality == 1)
+            {
+                std::cout << "  " << sampleRate << " Hz Normal: latency " << latency << std::endl;
+                EXPECT(latency == expectedLatency, "Normal FFT size does not follow the sample rate");
+            }
+
+            float maxError = 0.0f;
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = soothe.getMaxLatencySamples() * 2; i < length; ++i)
+                    maxError = std::max(maxError, std::abs(output.getSample(ch, i) - input.getSample(ch, i - latency)));
+
+            EXPECT(maxError < 1.0e-4f, "Soothe does not reconstruct its input at this sample rate");
+        }
+    }
+
+    std::cout << "  ✓ Soothe sample rate test passed" << std::endl;
+}
+
+TEST_CASE(testSootheOverlap, "soothe/overlap")
+{
+    // Every overlap's window pair is normalised exactly, so at zero amount
+    // the output nulls against the delayed input far below the framing
+    // test's tolerance. That holds for frames taking the unity shortcut and
+    // for frames forced through the attenuation and inverse FFT.
+    const char* const overlapNames[] = {"auto", "50%", "75%", "87.5%"};
+
+    for (int quality = 0; quality < 3; ++quality)
+    {
+        for (int overlap = 0; overlap < 4; ++overlap)
+        {
+            for (int scheduling : {0, 1})
+            {
+                TestParameters params;
+                setParam(params, ParamIDs::sootheAmount, 0.0f);
+                setParam(params, ParamIDs::sootheQuality, static_cast<float>(quality));
+                setParam(params, ParamIDs::sootheOverlap, static_cast<float>(overlap));
+                setParam(params, ParamIDs::sootheScheduling, static_cast<float>(scheduling));
+
+                const auto shortcut = renderNullError(params, 256);
+                const auto processed = renderNullError(params, 256, false);
+
+                EXPECT(shortcut.maxError < 1.0e-5f, "Soothe overlap-add is not normalised exactly");
+                EXPECT(processed.maxError < 1.0e-5f, "Soothe's inverse FFT path does not reconstruct its input");
+
+                if (scheduling == 0)
+                    std::cout << "  Quality " << quality << " overlap " << overlapNames[overlap]
+                              << ": latency " << shortcut.latency << ", max error " << shortcut.maxError
+                              << " (inverse FFT " << processed.maxError << ")" << std::endl;
+            }
+        }
+    }
+
+    std::cout << "  ✓ Soothe overlap test passed" << std::endl;
+}
+
+TEST_CASE(testSootheUnityToggle, "soothe/unity-toggle")
+{
+    // Amount switching on and off moves frames between the unity shortcut
+    // and the inverse FFT. The output must follow the always-full path
+    // through every switch, with no step where the paths hand over.
+    constexpr int blockSize = 256;
+    constexpr int blocksPerSegment = 258;  // ~1.5 s: time to release to unity at full speed
+    constexpr int numSegments = 4;
+    constexpr int length = blockSize * blocksPerSegment * numSegments;
+
+    juce::AudioBuffer<float> input(2, length);
+    float inputStep = 0.0f;
+
+    for (int i = 0; i < length; ++i)
+    {
+        const float t = static_cast<float>(i) / 44100.0f;
+        const float sample = 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 2500.0f * t)
+                           + 0.3f * std::sin(2.0f * juce::MathConstants<float>::pi * 440.0f * t);
+        input.setSample(0, i, sample);
+        input.setSample(1, i, sample);
+
+        if (i > 0)
+            inputStep = std::max(inputStep, std::abs(sample - input.getSample(0, i - 1)));
+    }
+
+    TestParameters params;
+    setParam(params, ParamIDs::sootheQuality, 1.0f);
+    setParam(params, ParamIDs::sootheSensitivity, 100.0f);
+    setParam(params, ParamIDs::sootheSpeed, 100.0f);
+
+    juce::AudioBuffer<float> shortcut(input), full(input);
+    SootheModule shortcutSoothe, fullSoothe;
+    fullSoothe.setUnityShortcut(false);
+
+    shortcutSoothe.prepare({44100.0, blockSize, 2});
+    fullSoothe.prepare({44100.0, blockSize, 2});
+
+    for (int b = 0; b < length / blockSize; ++b)
+    {
+        // Off, on, off, on: each switch crosses the unity threshold
+        if (b % blocksPerSegment == 0)
+        {
+            setParam(params, ParamIDs::sootheAmount, (b / blocksPerSegment) % 2 == 0 ? 0.0f : 100.0f);
+        }
+
+        auto shortcutBlock = juce::dsp::AudioBlock<float>(shortcut).getSubBlock(static_cast<size_t>(b * blockSize), static_cast<size_t>(blockSize));
+        auto fullBlock = juce::dsp::AudioBlock<float>(full).getSubBlock(static_cast<size_t>(b * blockSize), static_cast<size_t>(blockSize));
+        shortcutSoothe.processActive(shortcutBlock, params);
+        fullSoothe.processActive(fullBlock, params);
+    }
+
+    const int latency = shortcutSoothe.getLatencySamples();
+    float pathError = 0.0f, outputStep = 0.0f, cut = 0.0f;
+
+    for (int i = latency + 1; i < length; ++i)
+    {
+        pathError = std::max(pathError, std::abs(shortcut.getSample(0, i) - full.getSample(0, i)));
+        outputStep = std::max(outputStep, std::abs(shortcut.getSample(0, i) - shortcut.getSample(0, i - 1)));
+    }
+
+    // The "on" segments really attenuate, and each "off" one settles back
+    // to a null before the next switch
+    for (int segment = 0; segment < numSegments; ++segment)
+    {
+        const int segmentEnd = (segment + 1) * blocksPerSegment * blockSize;
+        float error = 0.0f;
+
+        for (int i = segmentEnd - blockSize; i < segmentEnd; ++i)
+            error = std::max(error, std::abs(shortcut.getSample(0, i) - input.getSample(0, i - latency)));
+
+        if (segment % 2 == 0)
+            EXPECT(error < 1.0e-5f, "Soothe did not release to unity after amount was turned off");
+        else
+            cut = std::max(cut, error);
+    }
+
+    std::cout << "  Shortcut vs full path " << pathError << ", largest step " << outputStep
+              << " (input " << inputStep << "), attenuation " << cut << std::endl;
+
+    EXPECT(cut > 0.01f, "Soothe did not attenuate while amount was on");
+    EXPECT(pathError < 1.0e-5f, "Switching to and from the unity shortcut changed the output");
+    EXPECT(outputStep < 2.0f * inputStep, "Switching to and from the unity shortcut left a discontinuity");
+    std::cout << "  ✓ Soothe unity toggle test passed" << std::endl;
+}
+
+TEST_CASE(testSootheWorker, "soothe/worker")
+{
+    // The worker's curves must reach the audio thread: a steady resonant tone
+    // ends up attenuated about as much as with inline analysis
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = 44100.0;
+    spec.maximumBlockSize = 512;
+    spec.numChannels = 2;
+
+    auto render = [&](int scheduling) {
+        TestParameters params;
+        setParam(params, ParamIDs::sootheAmount, 100.0f);
+        setParam(params, ParamIDs::sootheSensitivity, 100.0f);
+        setParam(params, ParamIDs::sootheScheduling, static_cast<float>(scheduling));
+
+        SootheModule soothe;
+        soothe.prepare(spec);
+
+        // The worker thread only exists once Worker scheduling is selected
+        soothe.updateSettings(params);
+        EXPECT(soothe.needsBackgroundThreads() == (scheduling == 2), "Worker thread wanted for the wrong scheduling");
+        soothe.startBackgroundThreads();
+        EXPECT(!soothe.needsBackgroundThreads(), "Worker thread did not start");
+
+        juce::AudioBuffer<float> buffer(2, 512);
+        double level = 0.0;
+        constexpr int numBlocks = 172;  // ~2 s
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 512; ++i)
+                    buffer.setSample(ch, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 2500.0f * static_cast<float>(b * 512 + i) / 44100.0f));
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            soothe.processActive(block, params);
+
+            // Give the worker time, as a real-time callback would
+            if (scheduling == 2)
+                juce::Thread::sleep(1);
+
+            if (b >= numBlocks / 2)
+                level += buffer.getRMSLevel(0, 0, 512);
+        }
+
+        return juce::Decibels::gainToDecibels(static_cast<float>(level / (numBlocks / 2)));
+    };
+
+    const float inlineLevel = render(0);
+    const float workerLevel = render(2);
+    const float inputLevel = juce::Decibels::gainToDecibels(0.5f / std::sqrt(2.0f));
+
+    std::cout << "  Input " << inputLevel << " dB, inline " << inlineLevel << " dB, worker " << workerLevel << " dB" << std::endl;
+
+    EXPECT(inlineLevel < inputLevel - 3.0f, "Inline analysis did not attenuate the resonance");
+    EXPECT(std::abs(workerLevel - inlineLevel) < 1.0f, "Worker analysis differs from inline analysis");
+    std::cout << "  ✓ Soothe worker test passed" << std::endl;
+}
+
+TEST_CASE(testSootheSharedPool, "soothe/shared-pool")
+{
+    // Pooled frames run the Spread pipeline on other threads (or inline at
+    // the deadline), so the output must match Spread exactly however the
+    // pool's threads are scheduled
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = 44100.0;
+    spec.maximumBlockSize = 256;
+    spec.numChannels = 2;
+
+    const auto input = Bench::createDrumLoopStimulus(spec.sampleRate, 44100);
+
+    auto render = [&](int scheduling) {
+        TestParameters params;
+        setParam(params, ParamIDs::sootheAmount, 70.0f);
+        setParam(params, ParamIDs::sootheSensitivity, 60.0f);
+        setParam(params, ParamIDs::sootheScheduling, static_cast<float>(scheduling));
+
+        // Several instances share the pool at once
+        std::array<SootheModule, 4> instances;
+        for (auto& soothe : instances)
+        {
+            soothe.prepare(spec);
+            soothe.updateSettings(params);
+            soothe.startBackgroundThreads();
+        }
+
+        std::array<juce::AudioBuffer<float>, 4> outputs;
+        for (auto& output : outputs)
+            output.makeCopyOf(input);
+
+        for (int start = 0; start + 256 <= input.getNumSamples(); start += 256)
+        {
+            for (size_t n = 0; n < instances.size(); ++n)
+            {
+                auto block = juce::dsp::AudioBlock<float>(outputs[n]).getSubBlock(static_cast<size_t>(start), 256);
+                instances[n].processActive(block, params);
+            }
+        }
+
+        return outputs;
+    };
+
+    juce::SharedResourcePointer<SpectralWorkerPool> pool;
+    const auto spread = render(1);
+    const auto lateBefore = pool->getNumLate();
+    const auto pooled = render(3);
+    const auto numLate = pool->getNumLate() - lateBefore;
+
+    EXPECT(pool->isStarted(), "Selecting Shared Pool did not start the pool");
+
+    // A frame a pool thread is still running at its deadline plays dry
+    // rather than being waited for; only then may the outputs differ
+    if (numLate == 0)
+    {
+        for (size_t n = 0; n < pooled.size(); ++n)
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    EXPECT(pooled[n].getSample(ch, i) == spread[0].getSample(ch, i), "Shared Pool output differs from Spread");
+    }
+    else
+    {
+        std::cout << "  " << numLate << " frames ran late; exact comparison skipped" << std::endl;
+    }
+
+    std::cout << "  ✓ Soothe shared pool test passed" << std::endl;
+}
+
+TEST_CASE(testSpectralPoolDeadline, "soothe/pool-deadline")
+{
+    // A job still running at its deadline is reported, not waited for
+    struct BlockingJob : SpectralWorkerPool::Job
+    {
+        std::atomic<bool> started{false};
+        std::atomic<bool> mayFinish{false};
+
+        void process() override
+        {
+            started.store(true);
+            while (!mayFinish.load())
+                std::this_thread::yield();
+        }
+    };
+
+    juce::SharedResourcePointer<SpectralWorkerPool> pool;
+    pool->start();
+
+    BlockingJob job;
+    EXPECT(pool->submit(job), "Pool refused a job");
+
+    while (!job.started.load())
+        std::this_thread::yield();
+
+    EXPECT(!pool->tryComplete(job), "Waited for a running job");
+
+    job.mayFinish.store(true);
+
+    // Once it has finished, the next deadline completes it
+    bool completed = false;
+    for (int attempt = 0; attempt < 1000 && !completed; ++attempt)
+    {
+        completed = pool->tryComplete(job);
+        if (!completed)
+            juce::Thread::sleep(1);
+    }
+
+    EXPECT(completed, "Finished job was not completed");
+    pool->release(job);
+
+    std::cout << "  ✓ Pool deadline test passed" << std::endl;
+}
+
+TEST_CASE(testSoothePoolReconfigure, "soothe/pool-reconfigure")
 {
-    std::cout << "=== Multi-Color Comp DSP Tests ===" << std::endl;
-    std::cout << std::endl;
+    // Resets (bypass toggles, falling asleep), route changes (state copies)
+    // and quality changes run on the audio thread. None may wait for a frame
+    // a pool thread is still running; they apply once it has finished.
+    const auto audioThread = std::this_thread::get_id();
+    std::atomic<bool> holdNext{true};
+    std::binary_semaphore entered{0}, mayFinish{0};
+
+    TestParameters params;
+    setParam(params, ParamIDs::sootheScheduling, 3.0f);  // Shared Pool
+
+    SootheModule soothe, other;
+
+    // Holds the first frame a pool thread picks up; inline ones pass
+    soothe.setPooledFrameHook([&] {
+        if (std::this_thread::get_id() != audioThread && holdNext.exchange(false))
+        {
+            entered.release();
+            mayFinish.acquire();
+        }
+    });
+
+    const juce::dsp::ProcessSpec spec{44100.0, 256, 2};
+    for (auto* module : {&soothe, &other})
+    {
+        module->prepare(spec);
+        module->updateSettings(params);
+        module->startBackgroundThreads();
+    }
+
+    juce::AudioBuffer<float> buffer(2, 256);
+    int position = 0;
+    bool finite = true;
+
+    auto processBlock = [&] {
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < 256; ++i)
+                buffer.setSample(ch, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 2500.0f * static_cast<float>(position + i) / 44100.0f));
+        position += 256;
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        soothe.processActive(block, params);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < 256; ++i)
+                finite = finite && std::isfinite(buffer.getSample(ch, i));
+    };
+
+    bool held = false;
+    for (int b = 0; b < 1000 && !held; ++b)
+    {
+        processBlock();
+        held = entered.try_acquire_for(std::chrono::milliseconds(1));
+    }
+
+    if (!held)
+    {
+        holdNext.store(false);
+        mayFinish.release();  // In case one arrived just after the last check
+    }
 
-    try
+    EXPECT(held, "No frame reached a pool thread");
+
+    // Lets the held frame go after 2 s at the latest, so a call that does
+    // wait shows up as slow instead of hanging the test
+    std::atomic<bool> done{false};
+    std::thread releaser([&] {
+        for (int i = 0; i < 200 && !done.load(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        mayFinish.release();
+    });
+    const juce::ScopeGuard joinReleaser{[&] { done.store(true); releaser.join(); }};
+
+    auto millisecondsFor = [](auto&& call) {
+        const double start = juce::Time::getMillisecondCounterHiRes();
+        call();
+        return juce::Time::getMillisecondCounterHiRes() - start;
+    };
+
+    const int latencyBefore = soothe.getLatencySamples();
+    bool copied = true;
+
+    const double resetMs = millisecondsFor([&] { soothe.reset(); });
+    const double copyMs = millisecondsFor([&] { copied = other.copyStateFrom(soothe); });
+
+    setParam(params, ParamIDs::sootheQuality, 2.0f);  // High
+    const double qualityMs = millisecondsFor(processBlock);
+    const bool qualityDeferred = soothe.getLatencySamples() == latencyBefore;
+
+    done.store(true);
+
+    std::cout << "  While a frame ran: reset " << resetMs << " ms, state copy " << copyMs
+              << " ms, quality change " << qualityMs << " ms" << std::endl;
+
+    EXPECT(resetMs < 500.0, "Reset waited for a running pool frame");
+    EXPECT(copyMs < 500.0, "State copy waited for a running pool frame");
+    EXPECT(qualityMs < 500.0, "Quality change waited for a running pool frame");
+    EXPECT(!copied, "State copied while a pool thread was writing it");
+    EXPECT(qualityDeferred, "Quality changed while a pool thread used the buffers");
+
+    // Once the frame is done, the deferred changes go through
+    bool qualityApplied = false;
+    for (int b = 0; b < 1000 && !qualityApplied; ++b)
     {
-        testCompressor();
-        testColor();
-        testBypass();
+        processBlock();
+        qualityApplied = soothe.getLatencySamples() != latencyBefore;
+    }
 
-        std::cout << "\n=== All tests passed! ===" << std::endl;
-        return 0;
+    for (int attempt = 0; attempt < 1000 && !copied; ++attempt)
+    {
+        processBlock();
+        copied = other.copyStateFrom(soothe);
     }
-    catch (const std::exception& e)
+
+    EXPECT(qualityApplied, "Deferred quality change never applied");
+    EXPECT(copied, "State copy never succeeded after the frame finished");
+    EXPECT(finite, "Non-finite output around the held frame");
+
+    std::cout << "  ✓ Soothe pool reconfiguration test passed" << std::endl;
+}
+
+TEST_CASE(testSootheLive, "soothe/live")
+{
+    // Live cuts a steady resonance with its filter bank at a fraction of the
+    // STFT's latency
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = 44100.0;
+    spec.maximumBlockSize = 512;
+    spec.numChannels = 2;
+
+    TestParameters params;
+    setParam(params, ParamIDs::sootheAmount, 100.0f);
+    setParam(params, ParamIDs::sootheSensitivity, 100.0f);
+    setParam(params, ParamIDs::sootheQuality, 3.0f);
+
+    // The right channel's cascade shares SIMD registers with the left one, so
+    // a second instance with a silent right channel must give the same left
+    SootheModule soothe, silentRight;
+    soothe.prepare(spec);
+    silentRight.prepare(spec);
+
+    juce::AudioBuffer<float> buffer(2, 512), reference(2, 512);
+    double level = 0.0;
+    float laneLeak = 0.0f;
+    constexpr int numBlocks = 172;  // ~2 s
+
+    for (int b = 0; b < numBlocks; ++b)
     {
-        std::cerr << "\n!!! Test failed: " << e.what() << std::endl;
-        return 1;
+        for (int i = 0; i < 512; ++i)
+        {
+            const float t = static_cast<float>(b * 512 + i) / 44100.0f;
+            const float left = 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 2500.0f * t);
+
+            buffer.setSample(0, i, left);
+            buffer.setSample(1, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 700.0f * t));
+            reference.setSample(0, i, left);
+            reference.setSample(1, i, 0.0f);
+        }
+
+        juce::dsp::AudioBlock<float> block(buffer);
+        soothe.processActive(block, params);
+
+        juce::dsp::AudioBlock<float> referenceBlock(reference);
+        silentRight.processActive(referenceBlock, params);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < 512; ++i)
+                EXPECT(std::isfinite(buffer.getSample(ch, i)), "Live filter bank produced a non-finite sample");
+
+        for (int i = 0; i < 512; ++i)
+        {
+            laneLeak = std::max(laneLeak, std::abs(buffer.getSample(0, i) - reference.getSample(0, i)));
+            laneLeak = std::max(laneLeak, std::abs(reference.getSample(1, i)));
+        }
+
+        if (b >= numBlocks / 2)
+            level += buffer.getRMSLevel(0, 0, 512);
     }
+
+    const float liveLevel = juce::Decibels::gainToDecibels(static_cast<float>(level / (numBlocks / 2)));
+    const float inputLevel = juce::Decibels::gainToDecibels(0.5f / std::sqrt(2.0f));
+
+    std::cout << "  Input " << inputLevel << " dB, live " << liveLevel << " dB, latency "
+              << soothe.getLatencySamples() << " samples" << std::endl;
+
+    EXPECT(liveLevel < inputLevel - 3.0f, "Live filter bank did not attenuate the resonance");
+    EXPECT(laneLeak == 0.0f, "Live filter bank leaked between channels");
+    EXPECT(soothe.getLatencySamples() <= 256, "Live latency is not a small hop");
+    std::cout << "  ✓ Soothe live test passed" << std::endl;
+}
+
+TEST_CASE(testSootheERBBands, "soothe/erb-bands")
+{
+    // Band-domain analysis must find the same resonance as the per-bin one,
+    // and leave the rest of the spectrum alone
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = 44100.0;
+    spec.maximumBlockSize = 512;
+    spec.numChannels = 2;
+
+    auto render = [&](int analysis, float frequency) {
+        TestParameters params;
+        setParam(params, ParamIDs::sootheAmount, 100.0f);
+        setParam(params, ParamIDs::sootheSensitivity, 100.0f);
+        setParam(params, ParamIDs::sootheAnalysis, static_cast<float>(analysis));
+
+        SootheModule soothe;
+        soothe.prepare(spec);
+
+        juce::AudioBuffer<float> buffer(2, 512);
+        double level = 0.0;
+        constexpr int numBlocks = 172;  // ~2 s
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int i = 0; i < 512; ++i)
+            {
+                // Resonant tone over a quiet bed of harmonics
+                const float t = static_cast<float>(b * 512 + i) / 44100.0f;
+                float sample = 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * frequency * t);
+
+                for (int h = 1; h <= 8; ++h)
+                    sample += 0.02f * std::sin(2.0f * juce::MathConstants<float>::pi * 110.0f * static_cast<float>(h) * t);
+
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+            }
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            soothe.processActive(block, params);
+
+            if (b >= numBlocks / 2)
+                level += buffer.getRMSLevel(0, 0, 512);
+        }
+
+        return juce::Decibels::gainToDecibels(static_cast<float>(level / (numBlocks / 2)));
+    };
+
+    const float linearLevel = render(0, 2500.0f);
+    const float erbLevel = render(1, 2500.0f);
+    const float inputLevel = juce::Decibels::gainToDecibels(0.5f / std::sqrt(2.0f));
+
+    std::cout << "  Input " << inputLevel << " dB, linear " << linearLevel << " dB, ERB " << erbLevel << " dB" << std::endl;
+
+    EXPECT(erbLevel < inputLevel - 3.0f, "ERB analysis did not attenuate the resonance");
+    EXPECT(std::abs(erbLevel - linearLevel) < 3.0f, "ERB analysis differs too much from linear analysis");
+    std::cout << "  ✓ Soothe ERB band test passed" << std::endl;
+}
+
+TEST_CASE(testSootheDisplay, "soothe/display")
+{
+    // Nothing is published until the display is enabled; then the decimated
+    // spectrum shows the tone at its level with the cut beneath it
+    TestParameters params;
+    setParam(params, ParamIDs::sootheAmount, 100.0f);
+    setParam(params, ParamIDs::sootheSensitivity, 100.0f);
+
+    SootheDisplay display;
+    SootheModule soothe;
+    soothe.setDisplay(&display);
+    soothe.prepare({44100.0, 512, 2});
+
+    juce::AudioBuffer<float> buffer(2, 512);
+
+    auto render = [&](int numBlocks) {
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 512; ++i)
+                    buffer.setSample(ch, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 2500.0f * static_cast<float>(b * 512 + i) / 44100.0f));
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            soothe.processActive(block, params);
+        }
+    };
+
+    render(16);
+    EXPECT(!display.getFrames().fetch(), "Published while the display was disabled");
+
+    display.setEnabled(true);
+    render(86);
+    EXPECT(display.getFrames().fetch(), "Nothing published while the display was enabled");
+
+    const auto& frame = display.getFrames().getReadBuffer();
+    // The display point whose span holds 2.5 kHz
+    const auto point = static_cast<size_t>(std::log(2500.0f / SootheDisplayFrame::minFrequency)
+                                           / std::log(SootheDisplayFrame::maxFrequency / SootheDisplayFrame::minFrequency)
+                                           * SootheDisplayFrame::numPoints);
+
+    const float toneDB = juce::Decibels::gainToDecibels(frame.magnitude[point]);
+    const float cutDB = juce::Decibels::gainToDecibels(frame.attenuation[point]);
+    std::cout << "  Tone " << toneDB << " dB, cut " << cutDB << " dB" << std::endl;
+
+    EXPECT(std::abs(toneDB - juce::Decibels::gainToDecibels(0.5f)) < 2.0f, "Displayed magnitude is not scaled to the tone's level");
+    EXPECT(cutDB < -3.0f, "Displayed attenuation misses the resonance");
+    EXPECT(frame.hasBaseline, "Inline analysis should publish its baseline");
+    std::cout << "  ✓ Soothe display test passed" << std::endl;
+}
+
+TEST_CASE(testSilenceDetector, "router/silence-detector")
+{
+    SilenceDetector detector;
+
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = 44100.0;
+    spec.maximumBlockSize = 512;
+    spec.numChannels = 2;
+
+    detector.prepare(spec);
+    detector.setTailSamples(2048);
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::dsp::AudioBlock<float> block(buffer);
+    buffer.clear();
+
+    // Chain keeps running until the tail has passed
+    for (int b = 0; b < 4; ++b)
+        EXPECT(detector.process(block), "Slept before the tail decayed");
+
+    EXPECT(!detector.process(block), "Did not sleep after the tail decayed");
+    EXPECT(detector.hasJustFallenAsleep(), "Did not report falling asleep");
+    EXPECT(!detector.process(block), "Woke up on silence");
+    EXPECT(detector.getNumSkippedBlocks() == 2, "Skipped block counter is wrong");
+
+    // A single sample wakes the chain for that block
+    buffer.setSample(1, 300, 0.01f);
+    EXPECT(detector.process(block), "Did not wake on signal");
+    EXPECT(!detector.isSleeping(), "Still sleeping after signal");
+
+    std::cout << "  Skipped blocks: " << detector.getNumSkippedBlocks() << std::endl;
+    std::cout << "  ✓ Silence detector test passed" << std::endl;
+}
+
+TEST_CASE(testBypassDropLatency, "router/bypass-drop-latency")
+{
+    // A module that only delays, standing in for Soothe's latency
+    constexpr int latency = 64;
+    constexpr int blockSize = 256;
+    constexpr float sineHz = 200.0f;
+
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = 44100.0;
+    spec.maximumBlockSize = blockSize;
+    spec.numChannels = 1;
+
+    ModuleBypass bypass;
+    bypass.prepare(spec, latency);
+    bypass.setDropLatencyWhenBypassed(true);
+
+    std::vector<float> moduleDelay(latency, 0.0f);
+    int delayPosition = 0;
+
+    juce::AudioBuffer<float> buffer(1, blockSize);
+    juce::dsp::AudioBlock<float> block(buffer);
+    int sampleIndex = 0;
+    float previous = 0.0f;
+    float maxStep = 0.0f;
+
+    auto processBlock = [&] {
+        for (int i = 0; i < blockSize; ++i, ++sampleIndex)
+            buffer.setSample(0, i, 0.5f * std::sin(juce::MathConstants<float>::twoPi * sineHz
+                                                   * static_cast<float>(sampleIndex) / 44100.0f));
+
+        auto runModule = [&] {
+            auto* data = buffer.getWritePointer(0);
+            for (int i = 0; i < blockSize; ++i)
+            {
+                std::swap(data[i], moduleDelay[static_cast<size_t>(delayPosition)]);
+                delayPosition = (delayPosition + 1) % latency;
+            }
+        };
+
+        if (bypass.isFullyActive())
+            runModule();
+        else if (bypass.isFullyBypassed())
+            bypass.processBypassed(block);
+        else
+        {
+            bypass.captureDry(block);
+            runModule();
+            bypass.mixWet(block);
+        }
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            maxStep = std::max(maxStep, std::abs(buffer.getSample(0, i) - previous));
+            previous = buffer.getSample(0, i);
+        }
+    };
+
+    // Start bypassed with the latency dropped, fade in, then fade out again
+    bypass.setBypassed(true, latency);
+    for (int b = 0; b < 4; ++b)
+        processBlock();
+
+    const float sineStep = 0.5f * juce::MathConstants<float>::twoPi * sineHz / 44100.0f;
+    EXPECT(maxStep <= sineStep * 1.01f, "Bypassed output is not the plain input");
+
+    if (bypass.setBypassed(false, latency))
+        std::fill(moduleDelay.begin(), moduleDelay.end(), 0.0f);
+
+    for (int b = 0; b < 8; ++b)
+        processBlock();
+
+    EXPECT(bypass.isFullyActive(), "Fade-in did not finish");
+
+    bypass.setBypassed(true, latency);
+    for (int b = 0; b < 8; ++b)
+        processBlock();
+
+    EXPECT(bypass.isFullyBypassed(), "Fade-out did not finish");
+
+    // Moving by the whole latency at once would step by up to ~0.8 here
+    EXPECT(maxStep < sineStep * 2.0f, "Latency change is not crossfaded");
+
+    std::cout << "  Largest step: " << maxStep << " (sine alone: " << sineStep << ")" << std::endl;
+    std::cout << "  ✓ Dropped-latency bypass test passed" << std::endl;
+}
+
+TEST_CASE(testRouteOrderings, "router/route-orderings")
+{
+    enum Stage { S, C, H };  // Soothe, Compressor, Harmonic color
+
+    // Expected order for each routing choice
+    const Stage orders[RouterModule::numRoutes][3] = {
+        {S, C, H}, {C, H, S}, {S, H, C}, {C, S, H}, {H, C, S}, {H, S, C}
+    };
+
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = 44100.0;
+    spec.maximumBlockSize = 512;
+    spec.numChannels = 2;
+
+    for (int route = 0; route < RouterModule::numRoutes; ++route)
+    {
+        TestParameters params;
+        setParam(params, ParamIDs::routing, static_cast<float>(route));
+        params.getAPVTS().getParameter(ParamIDs::sootheBypass)->setValueNotifyingHost(0.0f);
+
+        RouterModule router;
+        router.prepare(spec);
+
+        CompressorModule comp;
+        ColorModule color;
+        SootheModule soothe;
+        comp.prepare(spec);
+        color.prepare(spec);
+        soothe.prepare(spec);
+
+        float maxDiff = 0.0f;
+
+        for (int b = 0; b < 8; ++b)
+        {
+            juce::AudioBuffer<float> routed(2, 512);
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < 512; ++i)
+                {
+                    float t = static_cast<float>(b * 512 + i) / 44100.0f;
+                    routed.setSample(ch, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 220.0f * t)
+                                          + 0.2f * std::sin(2.0f * juce::MathConstants<float>::pi * 3150.0f * t));
+                }
+            }
+
+            juce::AudioBuffer<float> manual(routed);
+
+            // Through the router
+            juce::dsp::AudioBlock<float> routedBlock(routed);
+            juce::dsp::ProcessContextReplacing<float> context(routedBlock);
+            router.process(context, params);
+
+            // Chaining the modules by hand
+            juce::dsp::AudioBlock<float> manualBlock(manual);
+            for (auto stage : orders[route])
+            {
+                if (stage == S)
+                    soothe.process(manualBlock, params);
+                else if (stage == C)
+                    comp.process(manualBlock, params);
+                else
+                    color.process(manualBlock, params);
+            }
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 512; ++i)
+                    maxDiff = std::max(maxDiff, std::abs(routed.getSample(ch, i) - manual.getSample(ch, i)));
+        }
+
+        EXPECT(maxDiff < 1.0e-6f, "Route output does not match manual chaining");
+        std::cout << "  Route " << route << " max difference: " << maxDiff << std::endl;
+    }
+
+    std::cout << "  ✓ Route ordering test passed" << std::endl;
+}
+
+TEST_CASE(testRouteDisplayHandover, "router/display-handover")
+{
+    // Only the active chain writes the Soothe display. After a route change
+    // the incoming chain has taken it over, so frames keep arriving.
+    TestParameters params;
+    setParam(params, ParamIDs::sootheBypass, 0.0f);
+
+    RouterModule router;
+    router.prepare({44100.0, 512, 2});
+    router.getSootheDisplay().setEnabled(true);
+
+    juce::AudioBuffer<float> buffer(2, 512);
+
+    auto render = [&](int numBlocks) {
+        int numFrames = 0;
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 512; ++i)
+                    buffer.setSample(ch, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 2500.0f * static_cast<float>(b * 512 + i) / 44100.0f));
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            router.process(context, params);
+
+            if (router.getSootheDisplay().getFrames().fetch())
+                ++numFrames;
+        }
+
+        return numFrames;
+    };
+
+    const int before = render(32);
+
+    // The crossfade lasts Soothe's latency plus 20 ms: well under 16 blocks
+    setParam(params, ParamIDs::routing, 1.0f);
+    render(16);
+    const int after = render(32);
+
+    std::cout << "  Display frames before " << before << ", after the route change " << after << std::endl;
+
+    EXPECT(before > 0, "The active chain does not publish to the display");
+    EXPECT(after > 0, "The display was not handed to the incoming chain");
+    std::cout << "  ✓ Display handover test passed" << std::endl;
+}
+
+TEST_CASE(testRouteTransition, "router/route-transition")
+{
+    // Switch routing mid-stream on a steady signal. The crossfade between
+    // the outgoing and incoming chains must not step beyond what either
+    // route produces on its own, must end within Soothe's latency plus
+    // 20 ms, and must then leave only the active chain running.
+    constexpr int blockSize = 256;
+    constexpr double sampleRate = 44100.0;
+
+    TestParameters params;
+    setParam(params, ParamIDs::sootheBypass, 0.0f);
+    setParam(params, ParamIDs::routing, 0.0f);
+
+    RouterModule router;
+    router.prepare({sampleRate, static_cast<juce::uint32>(blockSize), 2});
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    int64_t position = 0;
+    float previous[2] = {};
+
+    // Largest sample-to-sample step of the output over the blocks rendered
+    auto render = [&](int numBlocks, std::function<void()> afterBlock = {}) {
+        float maxStep = 0.0f;
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(ch, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 110.0f
+                                                            * static_cast<float>(position + i) / static_cast<float>(sampleRate)));
+            position += blockSize;
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            router.process(context, params);
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    maxStep = std::max(maxStep, std::abs(buffer.getSample(ch, i) - previous[ch]));
+                    previous[ch] = buffer.getSample(ch, i);
+                }
+            }
+
+            if (afterBlock)
+                afterBlock();
+        }
+
+        return maxStep;
+    };
+
+    // Settle, then measure the outgoing route's own steps
+    render(64);
+    const float stepBefore = render(16);
+    EXPECT(router.getNumChainsProcessed() == 1, "Only the active chain should run before the change");
+
+    const int transitionLength = router.getLatencySamples() + static_cast<int>(0.02 * sampleRate);
+    const int maxTransitionBlocks = (transitionLength + blockSize - 1) / blockSize;
+
+    setParam(params, ParamIDs::routing, 4.0f);
+
+    int transitionBlocks = 0;
+    bool bothChainsRan = false;
+    const float stepDuring = render(maxTransitionBlocks + 4, [&] {
+        if (router.isRouteTransitioning())
+            ++transitionBlocks;
+        bothChainsRan |= router.getNumChainsProcessed() == 2;
+    });
+
+    // The incoming route's own steps, once it runs alone
+    int chainsAfter = 0;
+    const float stepAfter = render(16, [&] { chainsAfter = std::max(chainsAfter, router.getNumChainsProcessed()); });
+
+    std::cout << "  Transition: " << transitionBlocks << " blocks after the change (limit " << maxTransitionBlocks
+              << "), largest step " << stepDuring << " (routes alone: " << stepBefore << ", " << stepAfter << ")" << std::endl;
+
+    EXPECT(bothChainsRan, "Both chains should run during the crossfade");
+    // Checked after each block, so the last crossfade block already reads as done
+    EXPECT(transitionBlocks < maxTransitionBlocks, "Route transition outlasted its length");
+    EXPECT(!router.isRouteTransitioning(), "Route transition did not finish");
+    EXPECT(stepDuring <= std::max(stepBefore, stepAfter) * 1.25f, "Route change steps beyond the signal's own");
+    EXPECT(chainsAfter == 1, "The shadow chain still runs after the transition");
+
+    std::cout << "  ✓ Route transition test passed" << std::endl;
+}
+
+TEST_CASE(testProfiler, "router/profiling")
+{
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = 44100.0;
+    spec.maximumBlockSize = 512;
+    spec.numChannels = 2;
+
+    TestParameters params;
+    params.getAPVTS().getParameter(ParamIDs::sootheBypass)->setValueNotifyingHost(0.0f);
+
+    RouterModule router;
+    router.prepare(spec);
+    auto& profiler = router.getProfiler();
+
+    juce::AudioBuffer<float> buffer(2, 512);
+
+    auto processBlocks = [&](int numBlocks) {
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 512; ++i)
+                    buffer.setSample(ch, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 440.0f * static_cast<float>(b * 512 + i) / 44100.0f));
+
+            juce::dsp::AudioBlock<float> block(buffer);
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            router.process(context, params);
+        }
+    };
+
+    // Disabled by default: nothing is measured
+    processBlocks(8);
+    EXPECT(profiler.getStats(ProcessingProfiler::Total).maxMicroseconds == 0.0f, "Profiler measured while disabled");
+
+    profiler.setEnabled(true);
+    processBlocks(8);
+
+    const auto total = profiler.getStats(ProcessingProfiler::Total);
+    EXPECT(total.maxMicroseconds > 0.0f && total.averageLoad > 0.0f, "Profiler did not measure the chain");
+
+    float stageSum = 0.0f;
+    for (auto slot : {ProcessingProfiler::Soothe, ProcessingProfiler::Compressor, ProcessingProfiler::Color})
+    {
+        const auto stats = profiler.getStats(slot);
+        EXPECT(stats.maxMicroseconds > 0.0f, "Stage was not timed");
+        stageSum += stats.averageMicroseconds;
+    }
+
+    EXPECT(stageSum <= total.averageMicroseconds * 1.01f, "Stages take longer than the whole block");
+
+    std::cout << "  Total: " << total.averageMicroseconds << " us/block, load " << total.averageLoad * 100.0f << "%" << std::endl;
+    std::cout << "  ✓ Profiler test passed" << std::endl;
+}
+
+TEST_CASE(testTraceRecorder, "tracing/chrome-json")
+{
+    const auto file = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("mcc-trace-test.json");
+    constexpr int eventsPerThread = 1000;
+
+    {
+        TraceRecorder recorder(file, 256);
+
+        // Two producers racing a writer that is far smaller than the total
+        auto produce = [] {
+            for (int i = 0; i < eventsPerThread; ++i)
+            {
+                TraceRecorder::begin("outer");
+                TraceRecorder::end("outer");
+
+                if (i % 64 == 0)
+                    juce::Thread::sleep(1);
+            }
+        };
+
+        std::thread other(produce);
+        produce();
+        other.join();
+
+        std::cout << "  Dropped events: " << recorder.getNumDropped() << std::endl;
+        EXPECT(recorder.getNumDropped() < eventsPerThread * 4, "Every event was dropped");
+    }
+
+    const auto json = juce::JSON::parse(file);
+    const auto* events = json["traceEvents"].getArray();
+    EXPECT(events != nullptr, "Trace file is not valid Chrome trace JSON");
+
+    int numBegin = 0, numEnd = 0;
+    std::map<int, double> lastTimestamp;
+    bool ordered = true;
+
+    for (const auto& event : *events)
+    {
+        const auto phase = event["ph"].toString();
+
+        if (phase == "M")
+            continue;
+
+        if (phase == "B")
+            ++numBegin;
+        else if (phase == "E")
+            ++numEnd;
+
+        // Each thread's events come out in the order it recorded them
+        const int tid = event["tid"];
+        const double ts = event["ts"];
+        const auto previous = lastTimestamp.find(tid);
+
+        ordered = ordered && ts >= 0.0 && (previous == lastTimestamp.end() || ts >= previous->second);
+        lastTimestamp[tid] = ts;
+    }
+
+    file.deleteFile();
+
+    EXPECT(numBegin > 0 && numBegin + numEnd <= eventsPerThread * 4, "Unexpected number of events");
+    EXPECT(lastTimestamp.size() == 2, "Expected events from two threads");
+    EXPECT(ordered, "Events out of order within a thread");
+    std::cout << "  Recorded " << numBegin << " begin / " << numEnd << " end events" << std::endl;
+    std::cout << "  ✓ Trace recorder test passed" << std::endl;
+}
+
+TEST_CASE(testLoudnessMeter, "metering/loudness")
+{
+    // EBU Tech 3341 reference: 997 Hz sine at -23 dBFS on both channels reads -23 LUFS
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = 48000.0;
+    spec.maximumBlockSize = 512;
+    spec.numChannels = 2;
+
+    LoudnessMeter meter;
+    meter.prepare(spec);
+
+    const float amplitude = juce::Decibels::decibelsToGain(-23.0f);
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::dsp::AudioBlock<float> block(buffer);
+
+    // 10 s, in blocks that do not line up with the 100 ms sub-blocks
+    const int totalSamples = 480000;
+    for (int start = 0; start < totalSamples; start += 512)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < 512; ++i)
+                buffer.setSample(ch, i, amplitude * std::sin(2.0 * juce::MathConstants<double>::pi * 997.0 * (start + i) / 48000.0));
+
+        meter.process(block);
+    }
+
+    const auto& readings = meter.getReadings();
+    std::cout << "  M " << readings.momentary << "  S " << readings.shortTerm
+              << "  I " << readings.integrated << " LUFS  LRA " << readings.range
+              << " LU  TP " << readings.truePeak << " dBTP" << std::endl;
+
+    EXPECT(std::abs(readings.momentary + 23.0f) < 0.1f, "Momentary loudness is off");
+    EXPECT(std::abs(readings.shortTerm + 23.0f) < 0.1f, "Short-term loudness is off");
+    EXPECT(std::abs(readings.integrated + 23.0f) < 0.1f, "Integrated loudness is off");
+    EXPECT(readings.range < 0.2f, "Steady tone should have no loudness range");
+    EXPECT(std::abs(readings.truePeak + 23.0f) < 0.2f, "True peak is off");
+
+    // Silence is gated out of the integrated value but pulls momentary down
+    meter.processSilence(48000);
+    EXPECT(std::abs(meter.getReadings().integrated + 23.0f) < 0.15f, "Silence changed integrated loudness");
+    EXPECT(meter.getReadings().momentary <= LoudnessReadings::noReading, "Momentary did not fall on silence");
+
+    std::cout << "  ✓ Loudness meter test passed" << std::endl;
+}
+
+TEST_CASE(testMeterFrameMerge, "metering/frame-merge")
+{
+    // Two small blocks merged into one frame, as the processor does when the
+    // host's blocks are shorter than the meter frame
+    MeterFrame first;
+    first.inputPeak[0] = 0.5f;
+    first.inputRMS[0] = 0.2f;
+    first.grMin = -6.0f;
+    first.durationSeconds = 0.001f;
+
+    MeterFrame second;
+    second.inputPeak[0] = 0.25f;
+    second.inputRMS[0] = 0.4f;
+    second.grMin = -3.0f;
+    second.grMax = -1.0f;
+    second.durationSeconds = 0.003f;
+    second.inputLoudness.momentary = -20.0f;
+
+    first.merge(second);
+
+    const float expectedRMS = std::sqrt((0.2f * 0.2f * 1.0f + 0.4f * 0.4f * 3.0f) / 4.0f);
+
+    EXPECT(first.inputPeak[0] == 0.5f, "Peak was not held");
+    EXPECT(std::abs(first.inputRMS[0] - expectedRMS) < 1.0e-6f, "RMS is not energy-weighted");
+    EXPECT(first.grMin == -6.0f && first.grMax == 0.0f, "Gain reduction extremes were not held");
+    EXPECT(std::abs(first.durationSeconds - 0.004f) < 1.0e-9f, "Durations were not summed");
+    EXPECT(first.inputLoudness.momentary == -20.0f, "Loudness is not the newest reading");
+
+    std::cout << "  ✓ Meter frame merge test passed" << std::endl;
+}
+
+// ChainProcessor as the plugin runs it: latency changes wait for the
+// message thread, whose update the test delivers by hand
+class MessageThreadProcessor : public ChainProcessor
+{
+public:
+    MessageThreadProcessor() : ChainProcessor(LatencyReporting::MessageThread) {}
+
+    void deliverPendingUpdate() { handleAsyncUpdate(); }
+
+    const juce::String getName() const override { return "MultiColorComp (message thread)"; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+};
+
+TEST_CASE(testOfflineRender, "offline/block-sizes")
+{
+    // Renders the same file through OfflineRenderer at two block sizes. The
+    // outputs must match bit for bit and line up with the input, and the
+    // headless latency must be what the plugin reports.
+    constexpr double sampleRate = 44100.0;
+    constexpr int length = 44100;
+
+    juce::AudioBuffer<float> stimulus(2, length);
+    for (int i = 0; i < length; ++i)
+    {
+        const float t = static_cast<float>(i) / static_cast<float>(sampleRate);
+        stimulus.setSample(0, i, 0.5f * std::sin(2.0f * juce::MathConstants<float>::pi * 440.0f * t));
+        stimulus.setSample(1, i, 0.3f * std::sin(2.0f * juce::MathConstants<float>::pi * 1234.5f * t));
+    }
+
+    const auto tempDir = juce::File::getSpecialLocation(juce::File::tempDirectory);
+    const auto inputFile = tempDir.getNonexistentChildFile("mcc-offline-in", ".wav");
+    const auto outputFile = tempDir.getNonexistentChildFile("mcc-offline-out", ".wav");
+    const juce::ScopeGuard removeFiles{[&] { inputFile.deleteFile(); outputFile.deleteFile(); }};
+
+    {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(new juce::FileOutputStream(inputFile), sampleRate, 2, 32, {}, 0));
+        EXPECT(writer != nullptr, "Could not write the stimulus");
+        writer->writeFromAudioSampleBuffer(stimulus, 0, length);
+    }
+
+    using Preset = std::vector<std::pair<const char*, const char*>>;
+
+    auto render = [&](const Preset& preset, int blockSize) {
+        HeadlessProcessor host;
+        for (const auto& [id, value] : preset)
+            EXPECT(host.setParameter(id, value).wasOk(), "Preset value refused");
+
+        OfflineRenderer::Options options;
+        options.blockSize = blockSize;
+
+        const auto result = OfflineRenderer(host).render(inputFile, outputFile, options);
+        EXPECT(result.status.wasOk(), result.status.getErrorMessage().toStdString());
+        EXPECT(result.numSamples == length, "Rendered length differs from the input");
+
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(outputFile.createInputStream().release(), true));
+        EXPECT(reader != nullptr, "Could not read the render");
+
+        juce::AudioBuffer<float> output(2, length);
+        reader->read(&output, 0, length, 0, true, true);
+        return output;
+    };
+
+    auto maxDifference = [](const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int start) {
+        float maxDiff = 0.0f;
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = start; i < length; ++i)
+                maxDiff = std::max(maxDiff, std::abs(a.getSample(ch, i) - b.getSample(ch, i)));
+        return maxDiff;
+    };
+
+    // Soothe's STFT at High quality is the only latency; with nothing to
+    // attenuate it reconstructs its input
+    const Preset transparent = {{ParamIDs::compBypass, "1"}, {ParamIDs::colorBypass, "1"},
+                                {ParamIDs::sootheBypass, "0"}, {ParamIDs::sootheAmount, "0"},
+                                {ParamIDs::sootheQuality, "High"}};
+    const Preset processing = {{ParamIDs::compThreshold, "-30"}, {ParamIDs::compRatio, "4"},
+                               {ParamIDs::colorBypass, "0"}, {ParamIDs::colorDrive, "6"},
+                               {ParamIDs::sootheBypass, "0"}, {ParamIDs::sootheAmount, "60"},
+                               {ParamIDs::sootheQuality, "High"}};
+
+    for (const auto* preset : {&transparent, &processing})
+    {
+        const auto small = render(*preset, 64);
+        const auto large = render(*preset, 1000);
+        const float blockError = maxDifference(small, large, 0);
+
+        std::cout << "  " << (preset == &transparent ? "Transparent" : "Processing")
+                  << " preset, 64 vs 1000 sample blocks: max difference " << blockError << std::endl;
+        EXPECT(blockError == 0.0f, "Render depends on the block size");
+
+        // Compensated: sample i of the output is sample i of the input.
+        // The first window is still filling, as in the Soothe null tests.
+        if (preset == &transparent)
+        {
+            const float alignError = maxDifference(small, stimulus, 4096);
+            std::cout << "  Transparent render vs input: max difference " << alignError << std::endl;
+            EXPECT(alignError < 1.0e-4f, "Render is not latency-compensated");
+        }
+    }
+
+    // Immediate reporting (headless) and message-thread reporting (plugin)
+    // must end up with the same latency once a block has run
+    HeadlessProcessor headless;
+    for (const auto& [id, value] : transparent)
+        headless.setParameter(id, value);
+
+    juce::MemoryBlock state;
+    headless.getStateInformation(state);
+
+    MessageThreadProcessor plugin;
+    plugin.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    juce::MidiBuffer midi;
+
+    for (auto* processor : std::initializer_list<ChainProcessor*>{&headless, &plugin})
+    {
+        processor->setPlayConfigDetails(2, 2, sampleRate, 512);
+        processor->prepareToPlay(sampleRate, 512);
+        buffer.clear();
+        processor->processBlock(buffer, midi);
+    }
+
+    plugin.deliverPendingUpdate();
+
+    std::cout << "  Latency: headless " << headless.getLatencySamples() << ", plugin " << plugin.getLatencySamples() << std::endl;
+    EXPECT(headless.getLatencySamples() > 0, "High quality Soothe reports no latency");
+    EXPECT(headless.getLatencySamples() == plugin.getLatencySamples(), "Headless and plugin latency differ");
+
+    std::cout << "  ✓ Offline render test passed" << std::endl;
+}
+
+TEST_CASE(testChoiceCompatibility, "state/choice-compat")
+{
+    // Choice lists only ever grow at the end. A state saved before that
+    // holds the old index, which must recall the same choice.
+    auto choiceName = [](HeadlessProcessor& host, const char* id) {
+        return host.getParameters().getAPVTS().getParameter(id)->getCurrentValueAsText();
+    };
+
+    // XML states from before the binary format store the index as the value
+    juce::XmlElement xml("Parameters");
+    auto* routing = xml.createNewChildElement("PARAM");
+    routing->setAttribute("id", ParamIDs::routing);
+    routing->setAttribute("value", 1.0);
+    auto* quality = xml.createNewChildElement("PARAM");
+    quality->setAttribute("id", ParamIDs::sootheQuality);
+    quality->setAttribute("value", 2.0);  // High, the last entry before Live
+
+    juce::MemoryBlock legacy;
+    juce::AudioProcessor::copyXmlToBinary(xml, legacy);
+
+    HeadlessProcessor fromXml;
+    EXPECT(fromXml.getParameters().loadState(legacy.getData(), static_cast<int>(legacy.getSize())), "Legacy XML state refused");
+    EXPECT(choiceName(fromXml, ParamIDs::routing) == "Comp->Color->Soothe", "Legacy routing index recalled a different order");
+    EXPECT(choiceName(fromXml, ParamIDs::sootheQuality) == "High", "Legacy Soothe quality index recalled a different quality");
+
+    // Binary states store plain values, i.e. the index as well
+    HeadlessProcessor source;
+    source.setParameter(ParamIDs::routing, "1");
+    source.setParameter(ParamIDs::sootheQuality, "High");
+
+    juce::MemoryBlock blob;
+    source.getStateInformation(blob);
+
+    HeadlessProcessor fromBinary;
+    fromBinary.setStateInformation(blob.getData(), static_cast<int>(blob.getSize()));
+    EXPECT(choiceName(fromBinary, ParamIDs::routing) == "Comp->Color->Soothe", "Binary routing index recalled a different order");
+    EXPECT(choiceName(fromBinary, ParamIDs::sootheQuality) == "High", "Binary Soothe quality index recalled a different quality");
+
+    std::cout << "  ✓ Choice compatibility test passed" << std::endl;
+}
+
+TEST_CASE(testBinaryState, "state/binary")
+{
+    auto setAll = [](HeadlessProcessor& host) {
+        host.setParameter(ParamIDs::compThreshold, "-31.5");
+        host.setParameter(ParamIDs::compStyle, "Opto");
+        host.setParameter(ParamIDs::colorBypass, "1");
+        host.setParameter(ParamIDs::sootheFocusHigh, "8000");
+        host.setParameter(ParamIDs::routing, "4");
+    };
+
+    auto sameValues = [](HeadlessProcessor& a, HeadlessProcessor& b) {
+        auto& paramsA = static_cast<juce::AudioProcessor&>(a).getParameters();
+        auto& paramsB = static_cast<juce::AudioProcessor&>(b).getParameters();
+
+        for (int i = 0; i < paramsA.size(); ++i)
+            if (paramsA[i]->getValue() != paramsB[i]->getValue())
+                return false;
+
+        return true;
+    };
+
+    HeadlessProcessor source;
+    setAll(source);
+
+    juce::MemoryBlock blob;
+    source.getStateInformation(blob);
+    EXPECT(blob.getSize() > 8 && std::memcmp(blob.getData(), "MCCB", 4) == 0, "State is not in the binary format");
+
+    HeadlessProcessor restored;
+    restored.setStateInformation(blob.getData(), static_cast<int>(blob.getSize()));
+    EXPECT(sameValues(source, restored), "Binary state did not round-trip");
+
+    // Nothing changed: the cached blob comes back; a change is picked up
+    juce::MemoryBlock again;
+    source.getStateInformation(again);
+    EXPECT(again == blob, "Unchanged state saved differently");
+
+    source.setParameter(ParamIDs::compRatio, "8");
+    source.getStateInformation(again);
+    EXPECT(again != blob, "Changed parameter not saved");
+
+    // States from before the binary format are still read
+    HeadlessProcessor legacySource;
+    setAll(legacySource);
+    juce::MemoryBlock legacy;
+    std::unique_ptr<juce::XmlElement> xml(legacySource.getParameters().getAPVTS().copyState().createXml());
+    juce::AudioProcessor::copyXmlToBinary(*xml, legacy);
+
+    HeadlessProcessor fromLegacy;
+    fromLegacy.setStateInformation(legacy.getData(), static_cast<int>(legacy.getSize()));
+    EXPECT(sameValues(legacySource, fromLegacy), "Legacy XML state did not load");
+
+    // The format is little-endian whatever the host's byte order
+    auto* header = static_cast<const char*>(blob.getData());
+    EXPECT(juce::ByteOrder::littleEndianShort(header + 6) == static_cast<juce::uint16>(static_cast<juce::AudioProcessor&>(source).getParameters().size()),
+           "Parameter count is not stored little-endian");
+
+    auto patchFloat = [](juce::MemoryBlock& state, int index, float value) {
+        juce::uint32 bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = juce::ByteOrder::swapIfBigEndian(bits);
+        std::memcpy(static_cast<char*>(state.getData()) + 8 + 4 * index, &bits, sizeof(bits));
+    };
+
+    // A state with fewer parameters leaves the rest at their defaults
+    juce::MemoryBlock truncated(blob.getData(), 8 + 4 * 10);
+    const auto count = juce::ByteOrder::swapIfBigEndian(static_cast<juce::uint16>(10));
+    std::memcpy(static_cast<char*>(truncated.getData()) + 6, &count, sizeof(count));
+
+    HeadlessProcessor partial;
+    partial.setParameter(ParamIDs::sootheFocusHigh, "1000");
+    partial.setStateInformation(truncated.getData(), static_cast<int>(truncated.getSize()));
+
+    auto* threshold = partial.getParameters().getAPVTS().getParameter(ParamIDs::compThreshold);
+    auto* focusHigh = partial.getParameters().getAPVTS().getParameter(ParamIDs::sootheFocusHigh);
+    EXPECT(std::abs(threshold->convertFrom0to1(threshold->getValue()) + 31.5f) < 0.01f, "Stored parameter not read");
+    EXPECT(focusHigh->getValue() == focusHigh->getDefaultValue(), "Missing parameter not reset to its default");
+
+    // Garbage is refused without touching anything
+    const char junk[] = "MCCB\x07\x00\x01\x00";
+    EXPECT(!partial.getParameters().loadState(junk, 8), "Unknown version accepted");
+
+    juce::MemoryBlock corrupt(blob);
+    patchFloat(corrupt, 1, std::numeric_limits<float>::quiet_NaN());
+    EXPECT(!partial.getParameters().loadState(corrupt.getData(), static_cast<int>(corrupt.getSize())), "NaN value accepted");
+
+    corrupt = blob;
+    patchFloat(corrupt, 1, std::numeric_limits<float>::infinity());
+    EXPECT(!partial.getParameters().loadState(corrupt.getData(), static_cast<int>(corrupt.getSize())), "Infinite value accepted");
+    EXPECT(focusHigh->getValue() == focusHigh->getDefaultValue(), "Refused state changed a parameter");
+
+    // Out-of-range values are clamped to the parameter's range
+    corrupt = blob;
+    patchFloat(corrupt, 0, 1000.0f);  // Input trim, -24 to 24 dB
+    EXPECT(partial.getParameters().loadState(corrupt.getData(), static_cast<int>(corrupt.getSize())), "Out-of-range value refused");
+
+    auto* inputTrim = partial.getParameters().getAPVTS().getParameter(ParamIDs::inputTrim);
+    EXPECT(std::abs(inputTrim->convertFrom0to1(inputTrim->getValue()) - 24.0f) < 0.01f, "Out-of-range value not clamped");
+
+    std::cout << "  Binary state: " << blob.getSize() << " bytes (XML: " << legacy.getSize() << ")" << std::endl;
+    std::cout << "  ✓ Binary state test passed" << std::endl;
 }
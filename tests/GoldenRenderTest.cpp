@@ -0,0 +1,301 @@
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_dsp/juce_dsp.h>
+#include "../src/offline/HeadlessProcessor.h"
+#include "../src/dsp/CompressorModule.h"
+#include "../src/dsp/ColorModule.h"
+#include "../src/dsp/SootheModule.h"
+#include "../bench/Stimulus.h"
+#include "TestRegistry.h"
+#include <iostream>
+
+// Golden-render null tests: each module and route renders fixed stimuli with
+// a representative preset, and the result is nulled against a stored
+// reference. Missing references fail (skip with --allow-missing-golden);
+// --update-golden writes them.
+
+namespace
+{
+    constexpr double sampleRate = 44100.0;
+    constexpr int blockSize = 512;
+    constexpr int renderLength = 22050;  // 0.5 s
+
+    enum class Tolerance
+    {
+        BitExact,
+        Minus120dB,
+        Minus90dB
+    };
+
+    float getLimitDB(Tolerance tolerance)
+    {
+        switch (tolerance)
+        {
+            case Tolerance::BitExact:   return -1000.0f;
+            case Tolerance::Minus120dB: return -120.0f;
+            case Tolerance::Minus90dB:  return -90.0f;
+        }
+
+        return 0.0f;
+    }
+
+    // Log sweep 20 Hz - 20 kHz at -6 dBFS; right channel a quarter cycle ahead
+    juce::AudioBuffer<float> createSweep()
+    {
+        juce::AudioBuffer<float> buffer(2, renderLength);
+        const double duration = renderLength / sampleRate;
+        const double k = std::log(20000.0 / 20.0);
+
+        for (int i = 0; i < renderLength; ++i)
+        {
+            const double t = i / sampleRate;
+            const double phase = juce::MathConstants<double>::twoPi * 20.0 * duration / k * (std::exp(t / duration * k) - 1.0);
+            buffer.setSample(0, i, static_cast<float>(0.5 * std::sin(phase)));
+            buffer.setSample(1, i, static_cast<float>(0.5 * std::cos(phase)));
+        }
+
+        return buffer;
+    }
+
+    juce::AudioBuffer<float> createDrums()
+    {
+        return Bench::createDrumLoopStimulus(sampleRate, renderLength);
+    }
+
+    std::unique_ptr<HeadlessProcessor> createHost(const juce::StringPairArray& preset)
+    {
+        auto host = std::make_unique<HeadlessProcessor>();
+
+        for (const auto& id : preset.getAllKeys())
+        {
+            const auto result = host->setParameter(id, preset[id]);
+            EXPECT(result.wasOk(), result.getErrorMessage().toStdString());
+        }
+
+        return host;
+    }
+
+    template <typename Module>
+    juce::AudioBuffer<float> renderModule(const juce::StringPairArray& preset, juce::AudioBuffer<float> audio)
+    {
+        auto host = createHost(preset);
+        auto module = std::make_unique<Module>();
+
+        juce::dsp::ProcessSpec spec{sampleRate, static_cast<juce::uint32>(blockSize), 2};
+        module->prepare(spec);
+
+        for (int start = 0; start < audio.getNumSamples(); start += blockSize)
+        {
+            auto block = juce::dsp::AudioBlock<float>(audio).getSubBlock(static_cast<size_t>(start),
+                                                                          static_cast<size_t>(juce::jmin(blockSize, audio.getNumSamples() - start)));
+            module->processActive(block, host->getParameters());
+        }
+
+        return audio;
+    }
+
+    // Whole chain, as the plugin runs it
+    juce::AudioBuffer<float> renderChain(const juce::StringPairArray& preset, const juce::AudioBuffer<float>& input)
+    {
+        auto host = createHost(preset);
+        host->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+        host->prepareToPlay(sampleRate, blockSize);
+
+        juce::AudioBuffer<float> output(input);
+        juce::AudioBuffer<float> block(2, blockSize);
+        juce::MidiBuffer midi;
+
+        for (int start = 0; start < input.getNumSamples(); start += blockSize)
+        {
+            const int numSamples = juce::jmin(blockSize, input.getNumSamples() - start);
+            block.setSize(2, numSamples, false, false, true);
+
+            for (int ch = 0; ch < 2; ++ch)
+                block.copyFrom(ch, 0, input, ch, start, numSamples);
+
+            host->processBlock(block, midi);
+
+            for (int ch = 0; ch < 2; ++ch)
+                output.copyFrom(ch, start, block, ch, 0, numSamples);
+        }
+
+        return output;
+    }
+
+    juce::File getReferenceFile(const juce::String& testName)
+    {
+        return juce::File(juce::String(TestRegistry::getOptions().goldenDir))
+            .getChildFile(testName.fromFirstOccurrenceOf("golden/", false, false).replaceCharacter('/', '-') + ".wav");
+    }
+
+    void writeReference(const juce::File& file, const juce::AudioBuffer<float>& audio)
+    {
+        file.getParentDirectory().createDirectory();
+        file.deleteFile();
+
+        juce::WavAudioFormat wav;
+        auto stream = std::make_unique<juce::FileOutputStream>(file);
+        EXPECT(!stream->failedToOpen(), "Could not write " + file.getFullPathName().toStdString());
+
+        // 32-bit float keeps the render bit-exact
+        std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate,
+                                                                            static_cast<unsigned int>(audio.getNumChannels()),
+                                                                            32, {}, 0));
+        EXPECT(writer != nullptr, "Could not create a WAV writer");
+        stream.release();
+
+        writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+    }
+
+    juce::AudioBuffer<float> readReference(const juce::File& file)
+    {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+        EXPECT(reader != nullptr, "Unreadable reference " + file.getFullPathName().toStdString());
+
+        juce::AudioBuffer<float> audio(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+        reader->read(&audio, 0, audio.getNumSamples(), 0, true, true);
+        return audio;
+    }
+
+    // Nulls the render against its reference and reports the residual
+    void checkAgainstReference(const juce::String& testName, const juce::AudioBuffer<float>& rendered, Tolerance tolerance)
+    {
+        const auto file = getReferenceFile(testName);
+
+        if (TestRegistry::getOptions().updateGolden)
+        {
+            writeReference(file, rendered);
+            std::cout << "  updated " << file.getFullPathName() << std::endl;
+            return;
+        }
+
+        if (!file.existsAsFile())
+        {
+            const auto message = "no reference at " + file.getFullPathName().toStdString() + " (run with --update-golden)";
+
+            // A missing file must not read as a pass in CI
+            if (TestRegistry::getOptions().allowMissingGolden)
+                throw TestRegistry::Skipped(message);
+
+            throw TestRegistry::Failure(message);
+        }
+
+        const auto reference = readReference(file);
+        EXPECT(reference.getNumChannels() == rendered.getNumChannels()
+                   && reference.getNumSamples() == rendered.getNumSamples(),
+               "Reference has a different shape");
+
+        float worstError = 0.0f;
+        int worstSample = 0, worstChannel = 0;
+
+        for (int ch = 0; ch < rendered.getNumChannels(); ++ch)
+        {
+            for (int i = 0; i < rendered.getNumSamples(); ++i)
+            {
+                const float error = std::abs(rendered.getSample(ch, i) - reference.getSample(ch, i));
+
+                if (error > worstError)
+                {
+                    worstError = error;
+                    worstSample = i;
+                    worstChannel = ch;
+                }
+            }
+        }
+
+        const float residualDB = juce::Decibels::gainToDecibels(worstError, -1000.0f);
+
+        if (worstError == 0.0f)
+            std::cout << "  residual: bit-exact" << std::endl;
+        else
+            std::cout << "  residual: " << residualDB << " dBFS at sample " << worstSample << " (channel " << worstChannel << ")" << std::endl;
+
+        if (tolerance == Tolerance::BitExact)
+            EXPECT(worstError == 0.0f, "Output is not bit-exact");
+        else
+            EXPECT(residualDB <= getLimitDB(tolerance), "Residual exceeds the tolerance");
+    }
+
+    // Representative settings for each module
+    juce::StringPairArray compressorPreset(const char* style)
+    {
+        juce::StringPairArray preset;
+        preset.set(ParamIDs::compStyle, style);
+        preset.set(ParamIDs::compThreshold, "-24");
+        preset.set(ParamIDs::compRatio, "4");
+        preset.set(ParamIDs::compAttack, "5");
+        preset.set(ParamIDs::compRelease, "100");
+        return preset;
+    }
+
+    juce::StringPairArray colorPreset(const char* type)
+    {
+        juce::StringPairArray preset;
+        preset.set(ParamIDs::colorType, type);
+        preset.set(ParamIDs::colorDrive, "60");
+        preset.set(ParamIDs::colorTone, "10");
+        return preset;
+    }
+
+    juce::StringPairArray soothePreset(const char* quality)
+    {
+        juce::StringPairArray preset;
+        preset.set(ParamIDs::sootheBypass, "0");
+        preset.set(ParamIDs::sootheQuality, quality);
+        preset.set(ParamIDs::sootheAmount, "70");
+        preset.set(ParamIDs::sootheSensitivity, "60");
+        return preset;
+    }
+
+    juce::StringPairArray chainPreset(int route)
+    {
+        auto preset = compressorPreset("VCA");
+        preset.addArray(colorPreset("Tape"));
+        preset.addArray(soothePreset("Normal"));
+        preset.set(ParamIDs::routing, juce::String(route));
+        return preset;
+    }
+
+    void addGoldenTest(const juce::String& name, std::function<juce::AudioBuffer<float>()> render, Tolerance tolerance)
+    {
+        TestRegistry::add(name.toStdString(), [name, render, tolerance] {
+            checkAgainstReference(name, render(), tolerance);
+        });
+    }
+
+    [[maybe_unused]] const bool registered = [] {
+        for (auto* style : {"VCA", "FET", "Opto", "Vari-Mu"})
+            addGoldenTest(juce::String("golden/compressor/") + style,
+                          [style] { return renderModule<CompressorModule>(compressorPreset(style), createDrums()); },
+                          Tolerance::Minus120dB);
+
+        // Oversampling filters and waveshapers: allow for libm differences
+        for (auto* type : {"Tape", "Tube", "Transformer", "Clip"})
+            addGoldenTest(juce::String("golden/color/") + type,
+                          [type] { return renderModule<ColorModule>(colorPreset(type), createSweep()); },
+                          Tolerance::Minus90dB);
+
+        for (auto* quality : {"Eco", "Normal", "High"})
+            addGoldenTest(juce::String("golden/soothe/") + quality,
+                          [quality] { return renderModule<SootheModule>(soothePreset(quality), createDrums()); },
+                          Tolerance::Minus90dB);
+
+        for (int route = 0; route < RouterModule::numRoutes; ++route)
+            addGoldenTest("golden/route/" + juce::String(route),
+                          [route] { return renderChain(chainPreset(route), createDrums()); },
+                          Tolerance::Minus90dB);
+
+        // Everything bypassed: only delay lines and unity gains, so exact
+        addGoldenTest("golden/chain/all-bypassed",
+                      [] {
+                          juce::StringPairArray preset;
+                          preset.set(ParamIDs::compBypass, "1");
+                          preset.set(ParamIDs::colorBypass, "1");
+                          preset.set(ParamIDs::sootheBypass, "1");
+                          return renderChain(preset, createDrums());
+                      },
+                      Tolerance::BitExact);
+
+        return true;
+    }();
+}
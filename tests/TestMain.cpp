@@ -0,0 +1,98 @@
+#include "TestRegistry.h"
+#include <iostream>
+
+#ifndef MCC_GOLDEN_DIR
+ #define MCC_GOLDEN_DIR "golden"
+#endif
+
+namespace
+{
+    const char* const usage =
+        "Usage: CompressorTest [options]\n"
+        "  --filter <text>      Only run tests whose name contains text (repeatable)\n"
+        "  --list               Print test names and exit\n"
+        "  --golden-dir <dir>   Reference renders (default: tests/golden in the source tree)\n"
+        "  --update-golden      Rewrite reference renders from the current output\n"
+        "  --allow-missing-golden  Skip golden tests that have no reference (default: fail)\n";
+}
+
+int main(int argc, char* argv[])
+{
+    auto& options = TestRegistry::getOptions();
+    options.goldenDir = MCC_GOLDEN_DIR;
+
+    std::vector<std::string> filters;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+
+        if (arg == "--filter" && i + 1 < argc)
+            filters.push_back(argv[++i]);
+        else if (arg == "--golden-dir" && i + 1 < argc)
+            options.goldenDir = argv[++i];
+        else if (arg == "--update-golden")
+            options.updateGolden = true;
+        else if (arg == "--allow-missing-golden")
+            options.allowMissingGolden = true;
+        else if (arg == "--list")
+            listOnly = true;
+        else
+        {
+            std::cerr << "Unknown option: " << arg << "\n" << usage;
+            return 2;
+        }
+    }
+
+    auto selected = [&filters](const TestRegistry::TestCase& test) {
+        if (filters.empty())
+            return true;
+
+        for (const auto& filter : filters)
+            if (test.name.find(filter) != std::string::npos)
+                return true;
+
+        return false;
+    };
+
+    std::cout << "=== Multi-Color Comp DSP Tests ===" << std::endl;
+
+    int passed = 0, failed = 0, skipped = 0;
+
+    for (const auto& test : TestRegistry::getTests())
+    {
+        if (!selected(test))
+            continue;
+
+        if (listOnly)
+        {
+            std::cout << test.name << std::endl;
+            continue;
+        }
+
+        std::cout << "\n[" << test.name << "]" << std::endl;
+
+        try
+        {
+            test.run();
+            ++passed;
+        }
+        catch (const TestRegistry::Skipped& e)
+        {
+            std::cout << "  - skipped: " << e.what() << std::endl;
+            ++skipped;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "  !!! FAILED: " << e.what() << std::endl;
+            ++failed;
+        }
+    }
+
+    if (listOnly)
+        return 0;
+
+    std::cout << "\n=== " << passed << " passed, " << failed << " failed, " << skipped << " skipped ===" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Minimal self-registering test cases
+ * TEST_CASE(function, "group/name") registers a test at static-init time;
+ * tests can also be added in a loop with TestRegistry::add(). EXPECT()
+ * throws on failure, so one failing case does not stop the others and
+ * checks stay active in release builds (unlike assert).
+ */
+namespace TestRegistry
+{
+    struct TestCase
+    {
+        std::string name;
+        std::function<void()> run;
+    };
+
+    inline std::vector<TestCase>& getTests()
+    {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    inline void add(std::string name, std::function<void()> run)
+    {
+        getTests().push_back({std::move(name), std::move(run)});
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, void (*function)()) { add(name, function); }
+    };
+
+    class Failure : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    // Thrown when a test cannot run here (e.g. a missing reference file)
+    class Skipped : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    // Command-line settings visible to tests
+    struct Options
+    {
+        std::string goldenDir;
+        bool updateGolden = false;
+        bool allowMissingGolden = false;  // Skip, rather than fail, without a reference
+    };
+
+    inline Options& getOptions()
+    {
+        static Options options;
+        return options;
+    }
+}
+
+#define TEST_CASE(function, name)                                                   \
+    static void function();                                                         \
+    static const TestRegistry::Registrar function##Registrar(name, &function);       \
+    static void function()
+
+#define EXPECT(condition, message)                                                  \
+    do                                                                              \
+    {                                                                               \
+        if (!(condition))                                                           \
+            throw TestRegistry::Failure(std::string(message) + " [" #condition "] (" \
+                                        + __FILE__ + ":" + std::to_string(__LINE__) + ")"); \
+    } while (false)
@@ -0,0 +1,273 @@
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_events/juce_events.h>
+#include "offline/HeadlessProcessor.h"
+#include "offline/OfflineRenderer.h"
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    const char* const usage =
+        "Usage: mcc-render [options] <input>...\n"
+        "\n"
+        "Renders WAV/AIFF files through the Multi-Color Comp chain.\n"
+        "\n"
+        "Options:\n"
+        "  -p, --preset <file>      Plugin state XML to load\n"
+        "  --param <id>=<value>     Set a parameter (repeatable, applied after the preset)\n"
+        "  -o, --output-dir <dir>   Where to write results (default: next to each input, *_mcc)\n"
+        "  -b, --block-size <n>     Processing block size (default 512)\n"
+        "  -j, --jobs <n>           Files rendered in parallel (default: number of cores)\n"
+        "  --bits <16|24|32>        Output bit depth (default: same as input)\n"
+        "  --tail                   Append the chain's ring-out after the input ends\n"
+        "  --list-params            Print parameter IDs and exit\n";
+
+    struct Settings
+    {
+        juce::File preset;
+        juce::StringPairArray params;
+        juce::File outputDir;
+        OfflineRenderer::Options options;
+        int numJobs = juce::SystemStats::getNumCpus();
+        juce::Array<juce::File> inputs;
+        bool listParams = false;
+    };
+
+    struct Task
+    {
+        juce::File input;
+        juce::File output;
+        OfflineRenderer::Result result;
+    };
+
+    juce::Result parseArguments(const juce::StringArray& args, Settings& settings)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto& arg = args[i];
+
+            auto nextValue = [&]() -> juce::String {
+                return i + 1 < args.size() ? args[++i] : juce::String();
+            };
+
+            if (arg == "-p" || arg == "--preset")
+                settings.preset = juce::File::getCurrentWorkingDirectory().getChildFile(nextValue());
+            else if (arg == "--param")
+            {
+                const auto assignment = nextValue();
+                if (!assignment.contains("="))
+                    return juce::Result::fail("--param expects <id>=<value>, got '" + assignment + "'");
+
+                settings.params.set(assignment.upToFirstOccurrenceOf("=", false, false).trim(),
+                                    assignment.fromFirstOccurrenceOf("=", false, false).trim());
+            }
+            else if (arg == "-o" || arg == "--output-dir")
+                settings.outputDir = juce::File::getCurrentWorkingDirectory().getChildFile(nextValue());
+            else if (arg == "-b" || arg == "--block-size")
+                settings.options.blockSize = nextValue().getIntValue();
+            else if (arg == "-j" || arg == "--jobs")
+                settings.numJobs = nextValue().getIntValue();
+            else if (arg == "--bits")
+                settings.options.bitDepth = nextValue().getIntValue();
+            else if (arg == "--tail")
+                settings.options.appendTail = true;
+            else if (arg == "--list-params")
+                settings.listParams = true;
+            else if (arg.startsWith("-"))
+                return juce::Result::fail("Unknown option: " + arg);
+            else
+                settings.inputs.add(juce::File::getCurrentWorkingDirectory().getChildFile(arg));
+        }
+
+        if (settings.options.blockSize < 1 || settings.options.blockSize > 65536)
+            return juce::Result::fail("Block size must be between 1 and 65536");
+
+        if (settings.numJobs < 1)
+            return juce::Result::fail("--jobs must be at least 1");
+
+        return juce::Result::ok();
+    }
+
+    // Presets are applied on the main thread, before any rendering starts
+    juce::Result configure(HeadlessProcessor& processor, const Settings& settings)
+    {
+        if (settings.preset != juce::File())
+        {
+            auto result = processor.loadStateFile(settings.preset);
+            if (result.failed())
+                return result;
+        }
+
+        for (const auto& id : settings.params.getAllKeys())
+        {
+            auto result = processor.setParameter(id, settings.params[id]);
+            if (result.failed())
+                return result;
+        }
+
+        return juce::Result::ok();
+    }
+
+    juce::File getOutputFile(const juce::File& input, const Settings& settings)
+    {
+        if (settings.outputDir != juce::File())
+            return settings.outputDir.getChildFile(input.getFileName());
+
+        return input.getSiblingFile(input.getFileNameWithoutExtension() + "_mcc" + input.getFileExtension());
+    }
+
+    /** Renders files from a shared task list until none are left */
+    class RenderWorker : public juce::ThreadPoolJob
+    {
+    public:
+        RenderWorker(std::unique_ptr<HeadlessProcessor> p, std::vector<Task>& t,
+                     std::atomic<size_t>& next, const OfflineRenderer::Options& o, juce::CriticalSection& lock)
+            : juce::ThreadPoolJob("mcc-render worker"), processor(std::move(p)), tasks(t),
+              nextTask(next), options(o), printLock(lock)
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            OfflineRenderer renderer(*processor);
+
+            for (size_t index = nextTask++; index < tasks.size() && !shouldExit(); index = nextTask++)
+            {
+                auto& task = tasks[index];
+                task.result = renderer.render(task.input, task.output, options);
+
+                const juce::ScopedLock sl(printLock);
+                report(task);
+            }
+
+            return jobHasFinished;
+        }
+
+        static void report(const Task& task)
+        {
+            const auto& r = task.result;
+
+            if (r.status.failed())
+            {
+                std::cerr << "FAILED  " << task.input.getFullPathName() << ": " << r.status.getErrorMessage() << std::endl;
+                return;
+            }
+
+            const double audioSeconds = r.numSamples / r.sampleRate;
+            std::cout << "ok      " << task.output.getFullPathName()
+                      << "  (" << juce::String(audioSeconds, 1) << " s, "
+                      << juce::String(audioSeconds / juce::jmax(1.0e-6, r.renderSeconds), 1) << "x realtime, "
+                      << "I " << juce::String(r.outputLoudness.integrated, 1) << " LUFS, "
+                      << "TP " << juce::String(r.outputLoudness.truePeak, 1) << " dBTP)" << std::endl;
+        }
+
+    private:
+        std::unique_ptr<HeadlessProcessor> processor;
+        std::vector<Task>& tasks;
+        std::atomic<size_t>& nextTask;
+        OfflineRenderer::Options options;
+        juce::CriticalSection& printLock;
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    // The parameter tree expects a message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add(juce::String::fromUTF8(argv[i]));
+
+    Settings settings;
+    const auto parsed = parseArguments(args, settings);
+
+    if (parsed.failed())
+    {
+        std::cerr << parsed.getErrorMessage() << "\n\n" << usage;
+        return 2;
+    }
+
+    if (settings.listParams)
+    {
+        HeadlessProcessor processor;
+        for (auto* param : static_cast<juce::AudioProcessor&>(processor).getParameters())
+            if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*>(param))
+                std::cout << ranged->getParameterID() << "  (" << ranged->getName(64) << ")" << std::endl;
+        return 0;
+    }
+
+    if (settings.inputs.isEmpty())
+    {
+        std::cerr << usage;
+        return 2;
+    }
+
+    if (settings.outputDir != juce::File() && !settings.outputDir.createDirectory())
+    {
+        std::cerr << "Could not create " << settings.outputDir.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    std::vector<Task> tasks;
+    for (const auto& input : settings.inputs)
+    {
+        const auto output = getOutputFile(input, settings);
+
+        if (settings.inputs.contains(output))
+        {
+            std::cerr << "Refusing to overwrite the input " << output.getFullPathName() << std::endl;
+            return 2;
+        }
+
+        // With --output-dir, inputs from different folders can share a name
+        for (const auto& task : tasks)
+        {
+            if (task.output == output)
+            {
+                std::cerr << task.input.getFullPathName() << " and " << input.getFullPathName()
+                          << " would both render to " << output.getFullPathName() << std::endl;
+                return 2;
+            }
+        }
+
+        tasks.push_back({input, output, {}});
+    }
+
+    // One processor per worker; files are handed out dynamically so long and
+    // short files balance across cores
+    const int numWorkers = juce::jmin(settings.numJobs, static_cast<int>(tasks.size()));
+    std::atomic<size_t> nextTask{0};
+    juce::CriticalSection printLock;
+
+    juce::ThreadPool pool(numWorkers);
+    std::vector<std::unique_ptr<RenderWorker>> workers;
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto processor = std::make_unique<HeadlessProcessor>();
+        const auto configured = configure(*processor, settings);
+
+        if (configured.failed())
+        {
+            std::cerr << configured.getErrorMessage() << std::endl;
+            return 2;
+        }
+
+        workers.push_back(std::make_unique<RenderWorker>(std::move(processor), tasks, nextTask, settings.options, printLock));
+        pool.addJob(workers.back().get(), false);
+    }
+
+    for (auto& worker : workers)
+        pool.waitForJobToFinish(worker.get(), -1);
+
+    int numFailed = 0;
+    for (const auto& task : tasks)
+        if (task.result.status.failed())
+            ++numFailed;
+
+    std::cout << (tasks.size() - static_cast<size_t>(numFailed)) << " of " << tasks.size() << " files rendered" << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}